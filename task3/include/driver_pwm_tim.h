@@ -65,6 +65,71 @@ typedef struct
     uint16_t      RESERVED15;
 } TIM_RegDef_t;
 
+/* RCC bits */
+#define RCC_TIM1EN          (1 << 11)   // APB2PCENR
+#define RCC_TIM2EN          (1 << 0)    // APB1PCENR
+
+/* TIM bits */
+#define TIM_CTLR1_CEN       (1 << 0)
+#define TIM_CTLR1_UDIS      (1 << 1)    // no update event (preloads held)
+#define TIM_CTLR1_ARPE      (1 << 7)
+#define TIM_SWEVGR_UG       (1 << 0)
+#define TIM_DMAINTENR_UDE   (1 << 8)    // DMA request on update
+#define TIM_DMACFGR_DBA(w)  ((w) << 0)  // burst base, in words from CTLR1
+#define TIM_DMACFGR_DBL(n)  (((n) - 1) << 8)    // burst of n registers
+#define TIM_DBA_CH1CVR      13          // offset of CH1CVR (0x34 / 4)
+#define TIM_BDTR_BKE        (1 << 12)
+#define TIM_BDTR_BKP        (1 << 13)
+#define TIM_BDTR_AOE        (1 << 14)
+#define TIM_BDTR_MOE        (1 << 15)
+#define TIM_OCM_PWM1        0x6         // OCxM: active while CNT < CCRx
+#define TIM_OC_PE           (1 << 3)    // OCxPE: CCRx preload
+
+/*
+ * TIM1 channels and their default pins (no remap):
+ *   CH1 PD2   CH2 PA1   CH3 PC3   CH4 PC4
+ *   CH1N PD0  CH2N PA2  CH3N PD1  BKIN PC2
+ * Outputs need GPIO_CNF_AF_PUSH_PULL, BKIN an input mode.
+ */
+typedef enum {
+    PWM_CH1 = 0,
+    PWM_CH2,
+    PWM_CH3,
+    PWM_CH4
+} PWM_Channel_t;
+
+#define PWM_CHANNELS        4
+
+/* HAL_PWM_ConfigChannel() output flags */
+#define PWM_OUT_P           0x01    // CHx output
+#define PWM_OUT_N           0x02    // CHxN complementary output (CH1-CH3)
+#define PWM_OUT_P_LOW       0x04    // CHx active low
+#define PWM_OUT_N_LOW       0x08    // CHxN active low
+
+/* HAL_PWM_ConfigBreak() flags */
+#define PWM_BRK_ENABLE      0x01    // BKIN stops the outputs (clears MOE)
+#define PWM_BRK_HIGH        0x02    // break when BKIN is high (default low)
+#define PWM_BRK_AUTO        0x04    // outputs resume at the next update
+
+/* HAL_PWM_StreamStart() flags */
+#define PWM_STREAM_CIRCULAR 0x01    // restart the table at the end
+
+/* HAL_PWM_Solve() goal */
+typedef enum {
+    PWM_FIT_EXACT = 0,      // smallest frequency error, then most steps
+    PWM_FIT_RESOLUTION      // most duty steps (smallest PSC)
+} PWM_FitMode_t;
+
+/* HAL_PWM_Solve() result */
+typedef struct {
+    uint16_t psc;           // PSC register value
+    uint16_t arr;           // ATRLR register value
+    uint32_t steps;         // duty steps per period (ARR + 1)
+    uint32_t freq_hz;       // achieved frequency, rounded
+    int32_t  err_ppm;       // (achieved - requested) / requested, ppm
+    uint32_t tries;         // PWM_FIT_EXACT trial divisions (search cost)
+} PWM_Fit_t;
+
 #if 0
 typedef struct
 {
@@ -82,9 +147,30 @@ typedef struct
 } RCC_RegDef_t;
 #endif
 
-void HAL_PWM_Init(uint32_t freq_hz, uint16_t resolution);
+uint32_t HAL_PWM_Init(uint32_t freq_hz, uint16_t resolution);
 void HAL_PWM_SetDuty(uint16_t duty);
 void HAL_PWM_Start(void);
 void HAL_PWM_Stop(void);
 
+// Multi-channel / complementary outputs (after HAL_PWM_Init)
+void HAL_PWM_ConfigChannel(PWM_Channel_t ch, uint8_t outputs);
+void HAL_PWM_SetDeadTime(uint32_t ns);
+void HAL_PWM_ConfigBreak(uint8_t flags);
+void HAL_PWM_SetDutyCh(PWM_Channel_t ch, uint16_t duty);
+void HAL_PWM_SetDutyAll(const uint16_t duty[PWM_CHANNELS]);
+
+// Frequency planning; SetFrequency keeps each channel's duty ratio
+uint8_t HAL_PWM_Solve(uint32_t timer_clk, uint32_t freq_hz, uint16_t min_steps,
+                      PWM_FitMode_t mode, PWM_Fit_t *fit);
+uint8_t HAL_PWM_SetFrequency(uint32_t freq_hz, uint16_t min_steps,
+                             PWM_FitMode_t mode, PWM_Fit_t *fit);
+void HAL_PWM_ApplyFit(const PWM_Fit_t *fit);
+
+// Duty streaming: TIM1 update DMA (DMA1 channel 5) writes a table to the CCRs
+uint8_t HAL_PWM_StreamStart(PWM_Channel_t first, uint8_t channels,
+                            const uint16_t *table, uint16_t frames,
+                            uint16_t periods, uint8_t flags);
+void HAL_PWM_StreamStop(void);
+uint8_t HAL_PWM_StreamBusy(void);
+
 #endif
@@ -44,6 +44,10 @@ typedef struct
 /* special value → print string only */
 #define UART_NO_NUMBER  -1
 
+/* HAL_UART_PrintNum() flags */
+#define UART_FMT_ZERO       0x01    // pad with '0' instead of ' '
+#define UART_FMT_UNSIGNED   0x02    // treat val as uint32_t
+
 
 void HAL_UART_Init(void);
 void HAL_UART_SendChar(char c);
@@ -56,6 +60,13 @@ void HAL_UART_SendChar(char c);
  */
 void HAL_UART_Print(const char *str, int32_t val, uint8_t base);
 
+// Division-free number output: fixed width/zero padding, fixed-point
+void HAL_UART_PrintNum(int32_t val, uint8_t base, uint8_t width, uint8_t flags);
+void HAL_UART_PrintFixed(int32_t val, uint8_t decimals, uint8_t width);
+
+// Minimal printf: %d %u %x %X %s %c %% with '0' flag and width
+void HAL_UART_Printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
 #endif /* __CH32V00x_USART_DEBUG_H */
 
 
@@ -0,0 +1,22 @@
+#ifndef PWM_WAVE_H
+#define PWM_WAVE_H
+
+#include <stdint.h>
+
+/*
+ * Duty table generators for HAL_PWM_StreamStart(). Each fills `len`
+ * entries with values from 0 to `max` (use the PWM step count, e.g.
+ * fit.steps or the Init resolution). Integer only, meant for setup
+ * time; tables that never change can also be const arrays in flash.
+ */
+
+// One full period of a raised sine: 0 → max → 0, starting at 0
+void WAVE_Sine(uint16_t *table, uint16_t len, uint16_t max);
+
+// Linear ramp 0 → max → 0
+void WAVE_Triangle(uint16_t *table, uint16_t len, uint16_t max);
+
+// Perceptual (CIE 1931 lightness) correction of a table, in place
+void WAVE_Gamma(uint16_t *table, uint16_t len, uint16_t max);
+
+#endif
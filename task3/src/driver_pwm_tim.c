@@ -1,4 +1,5 @@
 #include "driver_pwm_tim.h"
+#include "driver_dma.h"
 
 static uint16_t pwm_arr;
 
@@ -16,8 +17,8 @@ static uint16_t pwm_arr;
  *          ARR (Auto-Reload Register) value:
  *              ARR = resolution − 1
  *
- *          Prescaler value:
- *              PSC = (Timer_Clock / (freq_hz × resolution)) − 1
+ *          Prescaler value (rounded to nearest):
+ *              PSC = round(Timer_Clock / (freq_hz × resolution)) − 1
  *
  *          PWM Frequency:
  *              PWM_Freq = Timer_Clock /
@@ -36,50 +37,65 @@ static uint16_t pwm_arr;
  *          TIM1->CH1CVR     - Compare register (CCR1 duty value).
  *          TIM1->BDTR       - Break & Dead-Time (MOE bit).
  *          TIM1->CTLR1      - Control register (ARPE bit).
+ *          TIM1->SWEVGR     - UG loads PSC before the first period.
  * 
  * @note    - Enables clock for TIM1 on APB2 bus.
  *          - Calculates prescaler and auto-reload based on
  *            SystemCoreClock, frequency, and resolution.
- *          - Configures TIM1 Channel 1 in PWM Mode 1.
+ *          - PSC is clamped to 16 bits; check the returned frequency
+ *            when freq_hz × resolution does not divide the clock.
+ *            HAL_PWM_Solve() picks PSC and ARR together instead.
+ *          - Configures TIM1 Channel 1 in PWM Mode 1; other channels
+ *            are added with HAL_PWM_ConfigChannel().
  *          - Enables preload for CCR and ARR registers.
  *          - Enables main output (MOE) for advanced timer.
  *          - Duty cycle is initialized to 0%.
  *
- * @return  none
+ * @return  Achieved PWM frequency in Hz (rounded), 0 if invalid.
  *********************************************************************/
-void HAL_PWM_Init(uint32_t freq_hz, uint16_t resolution)
+uint32_t HAL_PWM_Init(uint32_t freq_hz, uint16_t resolution)
 {
     uint32_t prescaler;
     uint32_t timer_clk = SystemCoreClock;
+    uint64_t div;
+    uint32_t ticks;
+
+    if (freq_hz == 0 || resolution < 2)
+        return 0;
 
     /* Enable TIM1 clock only */
-    RCC->APB2PCENR |= (1 << 11);   // TIM1EN
+    RCC->APB2PCENR |= RCC_TIM1EN;
 
-    /* PWM frequency calculation */
+    /* PWM frequency calculation (64-bit: freq × resolution may overflow) */
     pwm_arr = resolution - 1;
-    prescaler = (timer_clk / (freq_hz * resolution)) - 1;
+    div = (uint64_t)freq_hz * resolution;
+    prescaler = ((uint64_t)timer_clk + div / 2) / div;
+
+    if (prescaler == 0)
+        prescaler = 1;
+    if (prescaler > 0x10000)
+        prescaler = 0x10000;
 
     /* Timer base */
-    TIM1->PSC   = prescaler;
+    TIM1->PSC   = prescaler - 1;
     TIM1->ATRLR = pwm_arr;
     TIM1->CNT   = 0;
 
-    /* PWM Mode 1 on CH1 */
-    TIM1->CHCTLR1 &= ~(0x7 << 4);
-    TIM1->CHCTLR1 |=  (0x6 << 4);   // OC1M = PWM1
-    TIM1->CHCTLR1 |=  (1 << 3);     // OC1PE
-
-    /* Enable CH1 output */
-    TIM1->CCER |= (1 << 0);
-
-    /* Initial duty */
-    TIM1->CH1CVR = 0;
+    /* PWM Mode 1 on CH1, output enabled, 0% duty */
+    HAL_PWM_ConfigChannel(PWM_CH1, PWM_OUT_P);
 
     /* Advanced timer main output enable */
-    TIM1->BDTR |= (1 << 15);        // MOE
+    TIM1->BDTR |= TIM_BDTR_MOE;
 
     /* Auto-reload preload */
-    TIM1->CTLR1 |= (1 << 7);        // ARPE
+    TIM1->CTLR1 |= TIM_CTLR1_ARPE;
+
+    /* PSC is buffered: load it now, not after the first period */
+    TIM1->SWEVGR = TIM_SWEVGR_UG;
+    TIM1->INTFR  = 0;
+
+    ticks = prescaler * resolution;
+    return (timer_clk + ticks / 2) / ticks;
 }
 
 /*********************************************************************
@@ -103,10 +119,7 @@ void HAL_PWM_Init(uint32_t freq_hz, uint16_t resolution)
  *********************************************************************/
 void HAL_PWM_SetDuty(uint16_t duty)
 {
-    if (duty > pwm_arr)
-        duty = pwm_arr;
-
-    TIM1->CH1CVR = duty;
+    HAL_PWM_SetDutyCh(PWM_CH1, duty);
 }
 
 /*********************************************************************
@@ -116,12 +129,14 @@ void HAL_PWM_SetDuty(uint16_t duty)
  *
  * @note    - Sets CEN (Counter Enable) bit in TIM1 control register.
  *          - Timer begins counting and PWM output becomes active.
+ *          - Also sets MOE, so it restarts the outputs after a break.
  *
  * @return  none
  *********************************************************************/
 void HAL_PWM_Start(void)
 {
-    TIM1->CTLR1 |= (1 << 0);        // CEN
+    TIM1->BDTR |= TIM_BDTR_MOE;     // re-enable outputs after a break
+    TIM1->CTLR1 |= TIM_CTLR1_CEN;
 }
 
 /*********************************************************************
@@ -136,5 +151,552 @@ void HAL_PWM_Start(void)
  *********************************************************************/
 void HAL_PWM_Stop(void)
 {
-    TIM1->CTLR1 &= ~(1 << 0);
+    TIM1->CTLR1 &= ~TIM_CTLR1_CEN;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_ConfigChannel
+ *
+ * @brief   Configures a TIM1 channel for PWM output.
+ *
+ * @param   ch       PWM_CH1 .. PWM_CH4.
+ * @param   outputs  PWM_OUT_P and/or PWM_OUT_N, optionally with
+ *                   PWM_OUT_P_LOW / PWM_OUT_N_LOW for active-low.
+ *
+ *  @registers
+ *          TIM1->CHCTLR1/2  - OCxM = PWM1, OCxPE (CH1/2 in CTLR1,
+ *                             CH3/4 in CTLR2, 8 bits per channel).
+ *          TIM1->CCER       - CCxE, CCxP, CCxNE, CCxNP (4 bits each).
+ *          TIM1->CHxCVR     - Duty reset to 0.
+ *
+ * @note    - CH4 has no complementary output; PWM_OUT_N is ignored.
+ *          - With both outputs enabled CHxN is the inverse of CHx,
+ *            separated by the dead-time (HAL_PWM_SetDeadTime()).
+ *          - Configure the pins as GPIO_CNF_AF_PUSH_PULL.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_ConfigChannel(PWM_Channel_t ch, uint8_t outputs)
+{
+    volatile uint16_t *ctlr = (ch < PWM_CH3) ? &TIM1->CHCTLR1 : &TIM1->CHCTLR2;
+    uint8_t shift = (ch & 1) ? 8 : 0;
+    uint16_t ccer = 0;
+
+    if (ch > PWM_CH4)
+        return;
+
+    if (ch == PWM_CH4)
+        outputs &= ~(PWM_OUT_N | PWM_OUT_N_LOW);
+
+    /* PWM Mode 1 with CCR preload */
+    *ctlr = (*ctlr & ~(0xFF << shift)) |
+            (((TIM_OCM_PWM1 << 4) | TIM_OC_PE) << shift);
+
+    (&TIM1->CH1CVR)[ch] = 0;
+
+    if (outputs & PWM_OUT_P)     ccer |= (1 << 0);
+    if (outputs & PWM_OUT_P_LOW) ccer |= (1 << 1);
+    if (outputs & PWM_OUT_N)     ccer |= (1 << 2);
+    if (outputs & PWM_OUT_N_LOW) ccer |= (1 << 3);
+
+    TIM1->CCER = (TIM1->CCER & ~(0xF << (ch * 4))) | (ccer << (ch * 4));
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_SetDeadTime
+ *
+ * @brief   Sets the dead-time between CHx and CHxN edges.
+ *
+ * @param   ns  Dead-time in nanoseconds (clamped to the maximum).
+ *
+ * @formulas
+ *          t = ns × SystemCoreClock / 10^9      (timer clock ticks)
+ *
+ *          DTG[7:0] encoding (BDTR):
+ *              0xxxxxxx  DT = DTG[6:0] × t            0 .. 127
+ *              10xxxxxx  DT = (64 + DTG[5:0]) × 2t    128 .. 254
+ *              110xxxxx  DT = (32 + DTG[4:0]) × 8t    256 .. 504
+ *              111xxxxx  DT = (32 + DTG[4:0]) × 16t   512 .. 1008
+ *
+ *  @registers
+ *          TIM1->BDTR       - DTG[7:0].
+ *
+ * @note    - Rounds up so the dead-time is never shorter than asked.
+ *          - Up to 1008 timer ticks: 1008 / SystemCoreClock, i.e.
+ *            42 us at the 24 MHz SYSCLK. Longer requests give the
+ *            maximum.
+ *          - ns is clamped to 1 ms before scaling, so the 32-bit
+ *            product cannot wrap into a short dead-time.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_SetDeadTime(uint32_t ns)
+{
+    uint32_t t;
+    uint8_t dtg;
+
+    /* 1 ms is past the 1008-tick maximum for any clock >= 1.008 MHz;
+       clamping first keeps ns x MHz inside 32 bits (179 ms at 24 MHz
+       used to overflow) */
+    if (ns > 1000000U)
+        ns = 1000000U;
+
+    t = (ns * (SystemCoreClock / 1000000U) + 999U) / 1000U;
+
+    if (t <= 127)
+        dtg = t;
+    else if (t <= 254)
+        dtg = 0x80 | (((t + 1) >> 1) - 64);
+    else if (t <= 504)
+        dtg = 0xC0 | (((t + 7) >> 3) - 32);
+    else if (t <= 1008)
+        dtg = 0xE0 | (((t + 15) >> 4) - 32);
+    else
+        dtg = 0xFF;
+
+    TIM1->BDTR = (TIM1->BDTR & ~0xFFU) | dtg;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_ConfigBreak
+ *
+ * @brief   Configures the break input (BKIN, PC2).
+ *
+ * @param   flags  PWM_BRK_ENABLE, PWM_BRK_HIGH, PWM_BRK_AUTO, or 0 to
+ *                 disable the break input.
+ *
+ *  @registers
+ *          TIM1->BDTR       - BKE, BKP, AOE.
+ *
+ * @note    - A break clears MOE in hardware: all outputs go inactive
+ *            immediately, independent of the CPU.
+ *          - Without PWM_BRK_AUTO the outputs stay off until
+ *            HAL_PWM_Start() sets MOE again.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_ConfigBreak(uint8_t flags)
+{
+    uint16_t bdtr = TIM1->BDTR & ~(TIM_BDTR_BKE | TIM_BDTR_BKP | TIM_BDTR_AOE);
+
+    if (flags & PWM_BRK_ENABLE) bdtr |= TIM_BDTR_BKE;
+    if (flags & PWM_BRK_HIGH)   bdtr |= TIM_BDTR_BKP;
+    if (flags & PWM_BRK_AUTO)   bdtr |= TIM_BDTR_AOE;
+
+    TIM1->BDTR = bdtr;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_SetDutyCh
+ *
+ * @brief   Updates the duty cycle of one channel.
+ *
+ * @param   ch    PWM_CH1 .. PWM_CH4.
+ * @param   duty  Duty value (0 to resolution-1, clamped).
+ *
+ * @note    Takes effect at the next update event (CCR preload).
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_SetDutyCh(PWM_Channel_t ch, uint16_t duty)
+{
+    if (ch > PWM_CH4)
+        return;
+
+    if (duty > pwm_arr)
+        duty = pwm_arr;
+
+    (&TIM1->CH1CVR)[ch] = duty;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_SetDutyAll
+ *
+ * @brief   Updates all four channels so they change in the same period.
+ *
+ * @param   duty  Duty values for CH1..CH4 (clamped).
+ *
+ *  @registers
+ *          TIM1->CTLR1      - UDIS held while the CCRs are written.
+ *          TIM1->CHxCVR     - Preloaded compare values.
+ *
+ * @note    - With UDIS set the preload registers are not copied, so an
+ *            update event in the middle of the writes cannot apply
+ *            only some of them. All four take effect together at the
+ *            first update after UDIS is cleared.
+ *          - Unused channels are written too; pass their old value.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_SetDutyAll(const uint16_t duty[PWM_CHANNELS])
+{
+    TIM1->CTLR1 |= TIM_CTLR1_UDIS;
+
+    for (uint8_t ch = 0; ch < PWM_CHANNELS; ch++)
+        (&TIM1->CH1CVR)[ch] = (duty[ch] > pwm_arr) ? pwm_arr : duty[ch];
+
+    TIM1->CTLR1 &= ~TIM_CTLR1_UDIS;
+}
+
+/*********************************************************************
+ * @fn      pwm_isqrt
+ *
+ * @brief   Integer square root, floor(sqrt(n)).
+ *
+ * @note    - Bit-by-bit method: shifts, adds and compares only, no
+ *            divide (RV32EC has none in hardware).
+ *
+ * @return  floor(sqrt(n)), at most 65535
+ *********************************************************************/
+static uint32_t pwm_isqrt(uint32_t n)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > n)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (n >= root + bit)
+        {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_Solve
+ *
+ * @brief   Finds the PSC/ARR pair for a PWM frequency.
+ *
+ * @param   timer_clk  Timer input clock in Hz (SystemCoreClock).
+ * @param   freq_hz    Requested PWM frequency in Hz.
+ * @param   min_steps  Fewest duty steps (ARR + 1) acceptable, >= 2.
+ * @param   mode       PWM_FIT_EXACT or PWM_FIT_RESOLUTION.
+ * @param   fit        Result.
+ *
+ * @formulas
+ *          N = round(Timer_Clock / freq_hz)    (ticks per period)
+ *          (PSC + 1) × (ARR + 1) ≈ N,   both factors 1 .. 65536
+ *
+ *          PWM_FIT_RESOLUTION:
+ *              PSC + 1 = ceil(N / 65536),  ARR + 1 = round(N / (PSC + 1))
+ *
+ *          PWM_FIT_EXACT: a factor pair P × A = N exactly, found by
+ *              trial division with d = 1 .. sqrt(N) (P = d or
+ *              P = N / d), with PSC + 1 <= N / min_steps. Of all
+ *              pairs, the one with the smallest P (most steps).
+ *              N has no such pair (e.g. N prime above 65536): same
+ *              result as PWM_FIT_RESOLUTION.
+ *
+ *          err_ppm = (Timer_Clock − freq_hz × P × A) × 10^6
+ *                    / (freq_hz × P × A)
+ *
+ * @note    - P × A = N is the closest any pair can get, so no other
+ *            candidates are tried.
+ *          - PWM_FIT_EXACT costs at most sqrt(N) tries, one libgcc
+ *            remainder each: N <= 65536 (freq_hz >= Timer_Clock /
+ *            65536) stops at d = 1, and a prime N near 24 million
+ *            (1 Hz at 24 MHz) is the worst case at 4897 tries. On
+ *            1 Hz .. 1 MHz at 24 MHz no frequency needs more than
+ *            1476. fit->tries reports the count.
+ *          - PWM_FIT_RESOLUTION is a single division.
+ *          - Does not touch the timer; pure function.
+ *
+ * @return  1 on success, 0 if the frequency needs fewer than
+ *          min_steps ticks or is out of range.
+ *********************************************************************/
+uint8_t HAL_PWM_Solve(uint32_t timer_clk, uint32_t freq_hz, uint16_t min_steps,
+                      PWM_FitMode_t mode, PWM_Fit_t *fit)
+{
+    uint32_t n, p_min, p_max;
+    uint32_t best_p, best_a = 0;
+    uint32_t tries = 0;
+    uint64_t pa;
+    int64_t diff;
+
+    if (freq_hz == 0 || fit == 0)
+        return 0;
+    if (min_steps < 2)
+        min_steps = 2;
+
+    n = (timer_clk + freq_hz / 2) / freq_hz;
+    if (n < min_steps)
+        return 0;
+
+    p_min = (n + 0xFFFF) >> 16;
+    p_max = n / min_steps;
+    if (p_max > 0x10000)
+        p_max = 0x10000;
+    if (p_min > p_max)
+        return 0;
+
+    best_p = p_min;
+
+    if (mode == PWM_FIT_EXACT)
+    {
+        uint32_t root = pwm_isqrt(n);
+        uint32_t d = (p_min < min_steps) ? p_min : min_steps;
+
+        /* d <= sqrt(N) <= 65535, so A = d always fits the ARR */
+        for (; d <= root; d++)
+        {
+            tries++;
+            if (n % d != 0)
+                continue;
+
+            /* P = d: the smallest P there can be, stop */
+            if (d >= p_min && d <= p_max)
+            {
+                best_p = d;
+                best_a = n / d;
+                break;
+            }
+
+            /* A = d: later (larger) d give a smaller P */
+            if (d >= min_steps && n / d <= p_max)
+            {
+                best_p = n / d;
+                best_a = d;
+            }
+        }
+    }
+
+    if (best_a == 0)
+    {
+        /* best_p × freq_hz <= timer_clk / min_steps: fits in 32 bits */
+        uint32_t q = best_p * freq_hz;
+
+        best_a = (timer_clk + q / 2) / q;
+        if (best_a < min_steps)
+            best_a = min_steps;
+        if (best_a > 0x10000)
+            best_a = 0x10000;
+    }
+
+    pa = (uint64_t)best_p * best_a;
+    diff = (int64_t)timer_clk - (int64_t)(pa * freq_hz);
+
+    fit->psc     = best_p - 1;
+    fit->arr     = best_a - 1;
+    fit->steps   = best_a;
+    fit->freq_hz = (timer_clk + pa / 2) / pa;
+    fit->err_ppm = diff * 1000000 / (int64_t)(pa * freq_hz);
+    fit->tries   = tries;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_SetFrequency
+ *
+ * @brief   Changes the PWM frequency while the timer runs.
+ *
+ * @param   freq_hz    New PWM frequency in Hz.
+ * @param   min_steps  Fewest duty steps acceptable (see HAL_PWM_Solve).
+ * @param   mode       PWM_FIT_EXACT or PWM_FIT_RESOLUTION.
+ * @param   fit        Optional result (may be NULL).
+ *
+ * @formulas
+ *          CCRx_new = CCRx × (ARR_new + 1) / (ARR_old + 1)
+ *
+ *  @registers
+ *          TIM1->CTLR1      - UDIS held while the preloads are written.
+ *          TIM1->PSC        - Buffered, loaded at the update event.
+ *          TIM1->ATRLR      - Buffered (ARPE), loaded at the update event.
+ *          TIM1->CHxCVR     - Rescaled, buffered (OCxPE).
+ *
+ * @note    - The running period always completes; PSC, ARR and the
+ *            rescaled duties all take effect at the same update event,
+ *            so there is no runt or stretched pulse.
+ *          - Duty ratios are kept; later HAL_PWM_SetDuty*() values
+ *            are in the new step count (fit->steps).
+ *          - If the counter is stopped, the values load immediately.
+ *          - Runs HAL_PWM_Solve() first: one division in
+ *            PWM_FIT_RESOLUTION mode, at most sqrt(N) remainders in
+ *            PWM_FIT_EXACT mode (see there). For a fixed, short call
+ *            from a control loop, solve in advance and use
+ *            HAL_PWM_ApplyFit().
+ *
+ * @return  1 on success, 0 if no PSC/ARR pair fits (timer unchanged).
+ *********************************************************************/
+uint8_t HAL_PWM_SetFrequency(uint32_t freq_hz, uint16_t min_steps,
+                             PWM_FitMode_t mode, PWM_Fit_t *fit)
+{
+    PWM_Fit_t f;
+
+    if (!HAL_PWM_Solve(SystemCoreClock, freq_hz, min_steps, mode, &f))
+        return 0;
+
+    HAL_PWM_ApplyFit(&f);
+
+    if (fit)
+        *fit = f;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_ApplyFit
+ *
+ * @brief   Loads a PSC/ARR pair from HAL_PWM_Solve() while the timer runs.
+ *
+ * @param   fit  Solved frequency (from HAL_PWM_Solve()).
+ *
+ * @formulas
+ *          CCRx_new = CCRx × (ARR_new + 1) / (ARR_old + 1)
+ *
+ *  @registers
+ *          Same as HAL_PWM_SetFrequency().
+ *
+ * @note    - Fixed, short run time: four multiply/divide pairs. Solve
+ *            the frequencies at setup and switch with this function
+ *            from a control loop.
+ *          - Same update-event behaviour as HAL_PWM_SetFrequency().
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_ApplyFit(const PWM_Fit_t *fit)
+{
+    uint32_t old_steps = (uint32_t)pwm_arr + 1;
+
+    TIM1->CTLR1 |= TIM_CTLR1_UDIS;
+
+    TIM1->PSC   = fit->psc;
+    TIM1->ATRLR = fit->arr;
+
+    for (uint8_t ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        uint32_t ccr = (&TIM1->CH1CVR)[ch];
+
+        ccr = (ccr * fit->steps + old_steps / 2) / old_steps;
+        (&TIM1->CH1CVR)[ch] = (ccr > fit->arr) ? fit->arr : ccr;
+    }
+
+    pwm_arr = fit->arr;
+
+    TIM1->CTLR1 &= ~TIM_CTLR1_UDIS;
+
+    if (!(TIM1->CTLR1 & TIM_CTLR1_CEN))
+    {
+        TIM1->SWEVGR = TIM_SWEVGR_UG;
+        TIM1->INTFR  = 0;
+    }
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_StreamStart
+ *
+ * @brief   Streams duty values from a table into the compare registers.
+ *
+ * @param   first     First channel written (PWM_CH1 .. PWM_CH4).
+ * @param   channels  Consecutive channels per frame (1 .. 4 - first).
+ * @param   table     Duty values, one frame = `channels` entries,
+ *                    interleaved (CHa, CHb, CHa, CHb, ...). May be a
+ *                    const table in flash.
+ * @param   frames    Number of frames in the table.
+ * @param   periods   PWM periods per frame (1 .. 256).
+ * @param   flags     PWM_STREAM_CIRCULAR to loop, 0 for one pass.
+ *
+ * @formulas
+ *          Frame rate = PWM_Freq / periods
+ *          Duration   = frames × periods / PWM_Freq
+ *
+ *  @registers
+ *          TIM1->RPTCR      - periods − 1: one update every `periods`.
+ *          TIM1->DMACFGR    - DBA = CHxCVR offset, DBL = channels.
+ *          TIM1->DMAINTENR  - UDE: DMA request on update.
+ *          DMA1 channel 5   - Memory → TIM1->DMAADR, 16 → 32 bit.
+ *
+ * @note    - Each update event bursts one frame through DMAADR into
+ *            the preloaded CCRs, which take effect at the next update,
+ *            so the values change on period boundaries with no CPU.
+ *          - Values are not clamped; keep them <= ARR + 1.
+ *          - RPTCR also delays HAL_PWM_SetDuty*() to the next frame.
+ *            HAL_PWM_StreamStop() sets it back to one period.
+ *          - DMA1 channel 5 is shared with USART1_RX.
+ *
+ * @return  1 if started, 0 on invalid arguments.
+ *********************************************************************/
+uint8_t HAL_PWM_StreamStart(PWM_Channel_t first, uint8_t channels,
+                            const uint16_t *table, uint16_t frames,
+                            uint16_t periods, uint8_t flags)
+{
+    DMA_Channel_RegDef_t *dma = DMA1_CH(DMA_CH_TIM1_UP);
+    uint32_t count = (uint32_t)frames * channels;
+    uint32_t cfgr;
+
+    if (first > PWM_CH4 || channels == 0 || first + channels > PWM_CHANNELS ||
+        table == 0 || count == 0 || count > 0xFFFF ||
+        periods == 0 || periods > 256)
+        return 0;
+
+    HAL_PWM_StreamStop();
+
+    RCC->AHBPCENR |= RCC_DMA1EN;
+
+    cfgr = DMA_CFGR_DIR | DMA_CFGR_MINC |
+           DMA_CFGR_PSIZE_32 | DMA_CFGR_MSIZE_16 | DMA_CFGR_PL_HIGH;
+    if (flags & PWM_STREAM_CIRCULAR)
+        cfgr |= DMA_CFGR_CIRC;
+
+    dma->PADDR = (uint32_t)(uintptr_t)&TIM1->DMAADR;
+    dma->MADDR = (uint32_t)(uintptr_t)table;
+    dma->CNTR  = count;
+    dma->CFGR  = cfgr;
+    DMA1->INTFCR = DMA_GIF(DMA_CH_TIM1_UP);
+    dma->CFGR  = cfgr | DMA_CFGR_EN;
+
+    TIM1->RPTCR   = periods - 1;
+    TIM1->DMACFGR = TIM_DMACFGR_DBA(TIM_DBA_CH1CVR + first) |
+                    TIM_DMACFGR_DBL(channels);
+    TIM1->DMAINTENR |= TIM_DMAINTENR_UDE;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_StreamStop
+ *
+ * @brief   Stops duty streaming; the last values stay in the CCRs.
+ *
+ *  @registers
+ *          TIM1->DMAINTENR  - UDE cleared.
+ *          TIM1->RPTCR      - Back to 0 (update every period).
+ *          DMA1 channel 5   - Disabled.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_PWM_StreamStop(void)
+{
+    TIM1->DMAINTENR &= ~TIM_DMAINTENR_UDE;
+    DMA1_CH(DMA_CH_TIM1_UP)->CFGR &= ~DMA_CFGR_EN;
+    TIM1->RPTCR = 0;
+}
+
+/*********************************************************************
+ * @fn      HAL_PWM_StreamBusy
+ *
+ * @brief   Checks whether a stream is still running.
+ *
+ * @note    A circular stream stays busy until HAL_PWM_StreamStop().
+ *          The last frame of a one-shot stream is still to be loaded
+ *          into the outputs when this first returns 0.
+ *
+ * @return  1 while the DMA channel still has frames to transfer.
+ *********************************************************************/
+uint8_t HAL_PWM_StreamBusy(void)
+{
+    DMA_Channel_RegDef_t *dma = DMA1_CH(DMA_CH_TIM1_UP);
+
+    return (dma->CFGR & DMA_CFGR_EN) && dma->CNTR != 0;
 }
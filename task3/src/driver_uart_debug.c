@@ -1,4 +1,5 @@
 #include <driver_usart_debug.h>
+#include <stdarg.h>
 
 /*********************************************************************
  * @fn      HAL_UART_Init
@@ -46,6 +47,99 @@ void HAL_UART_SendChar(char c)
     USART1->DATAR = c;
 }
 
+/*
+ * Number formatting without division. RV32EC has no divide instruction,
+ * so "% 10" and "/ 10" become libgcc calls costing hundreds of cycles per
+ * digit. Decimal digits are produced by repeated subtraction of powers of
+ * ten (at most 9 per digit) and hex digits by shifting out nibbles.
+ */
+static const uint32_t pow10_tab[10] =
+{
+    1000000000U, 100000000U, 10000000U, 1000000U, 100000U,
+    10000U, 1000U, 100U, 10U, 1U
+};
+
+/* Decimal digits of val into out (no leading zeros), returns length */
+static uint8_t fmt_dec(char *out, uint32_t val)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        uint32_t p = pow10_tab[i];
+        char d = '0';
+
+        while (val >= p)
+        {
+            val -= p;
+            d++;
+        }
+
+        if (n || d != '0' || i == 9)
+            out[n++] = d;
+    }
+
+    return n;
+}
+
+/* Internal uart_put_num() flag: lower-case hex digits (%x) */
+#define UART_FMT_LOWER      0x80
+
+/* Hex digits of val into out (no leading zeros), returns length */
+static uint8_t fmt_hex(char *out, uint32_t val, char alpha)
+{
+    uint8_t n = 0;
+
+    for (int8_t sh = 28; sh >= 0; sh -= 4)
+    {
+        uint8_t d = (val >> sh) & 0xF;
+
+        if (n || d || sh == 0)
+            out[n++] = (d < 10) ? ('0' + d) : (alpha + d - 10);
+    }
+
+    return n;
+}
+
+/*
+ * Emit a formatted number: optional sign, padding to width, and a
+ * decimal point before the last 'decimals' digits (fixed-point).
+ */
+static void uart_put_num(uint32_t mag, uint8_t neg, uint8_t base,
+                         uint8_t width, uint8_t flags, uint8_t decimals)
+{
+    char digits[12];
+    char alpha = (flags & UART_FMT_LOWER) ? 'a' : 'A';
+    uint8_t n = (base == 16) ? fmt_hex(digits, mag, alpha) : fmt_dec(digits, mag);
+
+    /* Fixed-point needs at least one digit before the point: 5 → "0.05" */
+    uint8_t lead = (decimals >= n) ? (decimals + 1 - n) : 0;
+    uint8_t len = neg + lead + n + (decimals ? 1 : 0);
+    uint8_t pad = (width > len) ? (width - len) : 0;
+
+    if (!(flags & UART_FMT_ZERO))
+        while (pad--)
+            HAL_UART_SendChar(' ');
+
+    if (neg)
+        HAL_UART_SendChar('-');
+
+    if (flags & UART_FMT_ZERO)
+        while (pad--)
+            HAL_UART_SendChar('0');
+
+    /* Zero-extended digits with the point before the last 'decimals' */
+    uint8_t total = lead + n;
+    uint8_t point = total - decimals;
+
+    for (uint8_t i = 0; i < total; i++)
+    {
+        if (decimals && i == point)
+            HAL_UART_SendChar('.');
+        HAL_UART_SendChar((i < lead) ? '0' : digits[i - lead]);
+    }
+}
+
 /*********************************************************************
  * @fn      HAL_UART_Print
  *
@@ -59,7 +153,8 @@ void HAL_UART_SendChar(char c)
  *
  * @note    - Only supports base 10 and 16.
  *          - For decimal, prints negative sign if value < 0.
- *          - Uses internal buffer to convert number to string.
+ *          - For hex, negative values print as 32-bit two's complement.
+ *          - Division-free (see fmt_dec()/fmt_hex()).
  */
 void HAL_UART_Print(const char *str, int32_t val, uint8_t base)
 {
@@ -74,33 +169,173 @@ void HAL_UART_Print(const char *str, int32_t val, uint8_t base)
     if (base != 10 && base != 16)
         return;
 
-    /* Zero */
-    if (val == 0)
-    {
-        HAL_UART_SendChar('0');
-        return;
-    }
+    HAL_UART_PrintNum(val, base, 0, 0);
+}
 
-    /* Negative decimal */
-    if (val < 0 && base == 10)
-    {
-        HAL_UART_SendChar('-');
-        val = -val;
-    }
+/*********************************************************************
+ * @fn      HAL_UART_PrintNum
+ *
+ * @brief   Sends a number with optional fixed width and zero padding.
+ *
+ * @param   val   - Value to print
+ * @param   base  - Numerical base (10 = decimal, 16 = hex)
+ * @param   width - Minimum field width (0 = no padding)
+ * @param   flags - UART_FMT_ZERO (pad with '0'), UART_FMT_UNSIGNED
+ *
+ * @return  none
+ *
+ * @note    - Hex is always unsigned.
+ *          - Example: HAL_UART_PrintNum(42, 10, 5, UART_FMT_ZERO) → "00042"
+ */
+void HAL_UART_PrintNum(int32_t val, uint8_t base, uint8_t width, uint8_t flags)
+{
+    uint8_t neg = (base == 10) && !(flags & UART_FMT_UNSIGNED) && (val < 0);
+    uint32_t mag = neg ? (0U - (uint32_t)val) : (uint32_t)val;
 
-    char buf[16];
-    uint8_t i = 0;
+    uart_put_num(mag, neg, base, width, flags, 0);
+}
 
-    /* Convert number to string */
-    while (val)
+/*********************************************************************
+ * @fn      HAL_UART_PrintFixed
+ *
+ * @brief   Sends a scaled integer as a fixed-point decimal number.
+ *
+ * @param   val      - Value scaled by 10^decimals
+ * @param   decimals - Digits after the decimal point (0-9)
+ * @param   width    - Minimum field width (0 = no padding)
+ *
+ * @return  none
+ *
+ * @note    - No division: the point is inserted into the digit string.
+ *          - Example: HAL_UART_PrintFixed(500, 1, 0) → "50.0"
+ *                     HAL_UART_PrintFixed(-5, 2, 0)  → "-0.05"
+ */
+void HAL_UART_PrintFixed(int32_t val, uint8_t decimals, uint8_t width)
+{
+    uint8_t neg = (val < 0);
+    uint32_t mag = neg ? (0U - (uint32_t)val) : (uint32_t)val;
+
+    if (decimals > 9)
+        decimals = 9;
+
+    uart_put_num(mag, neg, 10, width, 0, decimals);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_Printf
+ *
+ * @brief   Minimal printf that formats straight into the UART TX path.
+ *
+ * @param   fmt - Format string, followed by the arguments
+ *
+ * @return  none
+ *
+ * @note    - Conversions: %d %u %x %X %s %c %%, optional 'l' modifier.
+ *          - Flags/width: '0' for zero padding, decimal field width
+ *            (e.g. "%5d", "%04x", "%8s").
+ *          - No heap and no line buffer: characters go to
+ *            HAL_UART_SendChar() as they are produced; the only buffer
+ *            is the 12-byte digit array in uart_put_num().
+ *          - Division- and multiply-free, like HAL_UART_PrintNum().
+ *          - Arguments are checked by GCC (format attribute).
+ */
+void HAL_UART_Printf(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+
+    while (*fmt)
     {
-        uint8_t d = val % base;
-        buf[i++] = (d < 10) ? ('0' + d) : ('A' + d - 10);
-        val /= base;
+        char c = *fmt++;
+
+        if (c != '%')
+        {
+            HAL_UART_SendChar(c);
+            continue;
+        }
+
+        uint8_t flags = 0;
+        uint8_t width = 0;
+        uint8_t is_long = 0;
+
+        if (*fmt == '0')
+        {
+            flags |= UART_FMT_ZERO;
+            fmt++;
+        }
+
+        /* width * 10 as shifts: RV32EC has no multiply either */
+        while (*fmt >= '0' && *fmt <= '9')
+            width = (width << 3) + (width << 1) + (*fmt++ - '0');
+
+        if (*fmt == 'l')
+        {
+            is_long = 1;
+            fmt++;
+        }
+
+        switch (*fmt)
+        {
+            case 'd':
+            {
+                int32_t v = is_long ? (int32_t)va_arg(ap, long) : va_arg(ap, int);
+                uint8_t neg = (v < 0);
+                uart_put_num(neg ? (0U - (uint32_t)v) : (uint32_t)v, neg, 10, width, flags, 0);
+                break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            {
+                uint32_t v = is_long ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+
+                if (*fmt == 'x')
+                    flags |= UART_FMT_LOWER;
+
+                uart_put_num(v, 0, (*fmt == 'u') ? 10 : 16, width, flags, 0);
+                break;
+            }
+
+            case 's':
+            {
+                const char *str = va_arg(ap, const char *);
+                uint8_t len = 0;
+
+                while (str[len] && len < 255)
+                    len++;
+
+                while (width-- > len)
+                    HAL_UART_SendChar(' ');
+
+                while (*str)
+                    HAL_UART_SendChar(*str++);
+                break;
+            }
+
+            case 'c':
+                HAL_UART_SendChar((char)va_arg(ap, int));
+                break;
+
+            case '%':
+                HAL_UART_SendChar('%');
+                break;
+
+            case '\0':
+                /* Lone '%' at the end of the string */
+                va_end(ap);
+                return;
+
+            default:
+                /* Unknown conversion: print it as-is */
+                HAL_UART_SendChar('%');
+                HAL_UART_SendChar(*fmt);
+                break;
+        }
+
+        fmt++;
     }
 
-    /* Send number string in correct order */
-    while (i--)
-        HAL_UART_SendChar(buf[i]);
+    va_end(ap);
 }
-
@@ -1,10 +1,13 @@
 #include "driver_pwm_tim.h"
+#include "pwm_wave.h"
+
+#define BREATH_STEPS    250     // table entries per breath
+#define BREATH_PERIODS  8       // PWM periods per entry → 2 s per breath
+
+static uint16_t breath[BREATH_STEPS];
 
 int main(void)
 {
-    uint16_t duty = 0;
-    int16_t step = 25;
-
     SystemInit();
 
     // Initialize Delay 
@@ -24,26 +27,19 @@ int main(void)
     /* PWM init: 1kHz, 1000-step resolution */
     HAL_PWM_Init(1000, 1000);
     HAL_PWM_Start();
-    HAL_UART_Print("Frequency is 1kHz", UART_NO_NUMBER, 0);
-    HAL_UART_Print("\r\n", UART_NO_NUMBER, 0);
+    HAL_UART_Printf("Frequency is 1kHz\r\n");
+
+    /* Gamma-corrected breathing table, streamed by DMA */
+    WAVE_Triangle(breath, BREATH_STEPS, 1000);
+    WAVE_Gamma(breath, BREATH_STEPS, 1000);
+    HAL_PWM_StreamStart(PWM_CH1, 1, breath, BREATH_STEPS,
+                        BREATH_PERIODS, PWM_STREAM_CIRCULAR);
+    HAL_UART_Printf("Breathing: %u steps, %u ms each (DMA)\r\n",
+                    BREATH_STEPS, BREATH_PERIODS);
 
     while (1)
     {
-        HAL_PWM_SetDuty(duty);
-        // Calculate percentage (0 to 100)
-        uint16_t percent = duty / 10;
-
-        HAL_UART_Print("Duty = ", UART_NO_NUMBER, 0);
-        HAL_UART_Print("", duty, 10);   // Raw value (0-1000)
-        HAL_UART_Print(" (", UART_NO_NUMBER, 0);
-        HAL_UART_Print("", percent, 10); // Percentage value (0-100)
-        HAL_UART_Print("%)\r\n", UART_NO_NUMBER, 0);
-
-        duty += step;
-        if (duty >= 1000 || duty == 0)
-            step = -step;
-
-        HAL_Delay_ms(40);
+        /* Duty updates run from DMA; nothing to do here */
     }
     return 0;
 }
@@ -0,0 +1,140 @@
+#include "pwm_wave.h"
+
+/* sin(k × π/128) in Q15, k = 0..64 (quarter wave) */
+static const uint16_t wave_sin_q15[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+/* sin() of a 16-bit phase (0x10000 = 2π) in signed Q15 */
+static int32_t wave_sin(uint16_t phase)
+{
+    uint16_t q   = phase & 0x3FFF;
+    uint8_t  idx = q >> 8;
+    uint8_t  frac = q & 0xFF;
+    int32_t  v;
+
+    /* Mirror the quarter table for the 2nd and 4th quadrant */
+    if (phase & 0x4000)
+    {
+        q    = 0x4000 - q;
+        idx  = q >> 8;
+        frac = q & 0xFF;
+    }
+
+    if (idx >= 64)
+        v = wave_sin_q15[64];
+    else
+        v = wave_sin_q15[idx] +
+            (((int32_t)(wave_sin_q15[idx + 1] - wave_sin_q15[idx]) * frac) >> 8);
+
+    return (phase & 0x8000) ? -v : v;
+}
+
+/*********************************************************************
+ * @fn      WAVE_Sine
+ *
+ * @brief   Fills a table with one period of a raised sine.
+ *
+ * @param   table  Output, len entries.
+ * @param   len    Table length (one period).
+ * @param   max    Peak value.
+ *
+ * @formulas
+ *          table[i] = max × (1 − cos(2π × i / len)) / 2
+ *
+ * @note    Quarter-wave table with linear interpolation: error is
+ *          within about 0.06 % of max, mostly the final rounding.
+ *
+ * @return  none
+ *********************************************************************/
+void WAVE_Sine(uint16_t *table, uint16_t len, uint16_t max)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint16_t phase = ((uint32_t)i << 16) / len;
+        int32_t c = wave_sin(phase + 0x4000);           // cos, Q15
+        uint32_t r = (uint32_t)(32767 - c) >> 1;        // 0 .. 32767
+
+        table[i] = (r * max + 16383) / 32767;
+    }
+}
+
+/*********************************************************************
+ * @fn      WAVE_Triangle
+ *
+ * @brief   Fills a table with a linear up/down ramp.
+ *
+ * @param   table  Output, len entries.
+ * @param   len    Table length (one period).
+ * @param   max    Peak value, reached at len / 2 (even len).
+ *
+ * @formulas
+ *          table[i] = max × 2i / len            i <  len / 2
+ *          table[i] = max × 2(len − i) / len    i >= len / 2
+ *
+ * @return  none
+ *********************************************************************/
+void WAVE_Triangle(uint16_t *table, uint16_t len, uint16_t max)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint32_t x = (i <= len - i) ? i : (uint32_t)len - i;
+
+        table[i] = ((uint64_t)max * 2 * x + len / 2) / len;
+    }
+}
+
+/*********************************************************************
+ * @fn      WAVE_Gamma
+ *
+ * @brief   Maps linear brightness to duty so fades look even.
+ *
+ * @param   table  Values 0 .. max, replaced in place.
+ * @param   len    Number of entries.
+ * @param   max    Full-scale value.
+ *
+ * @formulas
+ *          L = 100 × v / max                   (lightness, %)
+ *          Y = L / 903.3                       L <= 8
+ *          Y = ((L + 16) / 116)^3              L >  8
+ *          v' = round(max × Y)
+ *
+ * @note    - The CIE curve is close to gamma 2.2 but needs only a cube,
+ *            so it stays in integer math.
+ *          - Apply to WAVE_Triangle() for a breathing LED, or to a
+ *            ramp for a fade-in.
+ *
+ * @return  none
+ *********************************************************************/
+void WAVE_Gamma(uint16_t *table, uint16_t len, uint16_t max)
+{
+    if (max == 0)
+        return;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint32_t v = table[i] > max ? max : table[i];
+
+        if (v * 100 <= 8U * max)
+        {
+            table[i] = (v * 1000 + 4516) / 9033;
+        }
+        else
+        {
+            /* t = (L + 16) / 116 in Q15, then t^3 */
+            uint32_t t = (((uint64_t)(100 * v + 16U * max)) << 15) /
+                         (116U * max);
+            uint32_t t3 = (((t * t) >> 15) * t) >> 15;
+
+            table[i] = (t3 * max + 16384) >> 15;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * Host test: HAL_PWM_Solve() over 1 Hz .. 1 MHz in both fit modes.
+ *
+ * Build and run (from task3):
+ *   gcc -std=gnu11 -O2 -Wall -Iinclude -Itest/stub test/test_pwm_solve.c src/driver_pwm_tim.c -o /tmp/test_pwm_solve && /tmp/test_pwm_solve
+ *
+ * The solver is pure arithmetic, so the real driver file links on the
+ * host; the functions that touch TIM1 are never called. Every result is
+ * checked from its register values alone: PSC + 1 and ARR + 1 within
+ * 1 .. 0x10000 (a wrap shows up as a wrong period), at least min_steps
+ * duty steps, and freq_hz/err_ppm equal to what (PSC + 1) x (ARR + 1)
+ * actually produces. PWM_FIT_EXACT is also checked against a brute-force
+ * factor search, and its cost (fit.tries) must stay within sqrt(N).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "driver_pwm_tim.h"
+
+#define TEST_FMAX   1000000UL
+
+uint32_t SystemCoreClock = 24000000UL;
+
+static unsigned long failures;
+
+static void fail(uint32_t clk, uint32_t f, uint16_t min_steps, PWM_FitMode_t mode,
+                 const char *what)
+{
+    if (failures++ < 10)
+        printf("FAIL %lu Hz at %lu MHz, min_steps %u, %s: %s\n", (unsigned long)f,
+               (unsigned long)(clk / 1000000), min_steps,
+               mode == PWM_FIT_EXACT ? "EXACT" : "RESOLUTION", what);
+}
+
+static uint32_t isqrt(uint32_t n)
+{
+    uint32_t r = 0;
+
+    while ((uint64_t)(r + 1) * (r + 1) <= n)
+        r++;
+    return r;
+}
+
+// Smallest P in [p_min, p_max] with P | n and n / P <= 0x10000, else 0
+static uint32_t brute_p(uint32_t n, uint32_t p_min, uint32_t p_max)
+{
+    for (uint32_t p = p_min; p <= p_max; p++)
+        if (n % p == 0)
+            return p;
+    return 0;
+}
+
+// Check one result; returns |err_ppm| recomputed from the registers
+static double check(uint32_t clk, uint32_t f, uint16_t min_steps, PWM_FitMode_t mode,
+                    const PWM_Fit_t *r)
+{
+    uint64_t pa = ((uint64_t)r->psc + 1) * ((uint64_t)r->arr + 1);
+    double   ppm = ((double)clk / pa - f) / f * 1e6;
+
+    /* PSC and ARR are uint16_t, so a prescaler or step count above
+       0x10000 would wrap; the period check below catches that */
+    if (pa == 0 || pa > (uint64_t)clk + clk / 2)
+        fail(clk, f, min_steps, mode, "PSC/ARR wrapped");
+    if (r->steps != (uint32_t)r->arr + 1)
+        fail(clk, f, min_steps, mode, "steps != ARR + 1");
+    if (r->steps < min_steps)
+        fail(clk, f, min_steps, mode, "fewer than min_steps");
+    if (r->freq_hz != (clk + pa / 2) / pa)
+        fail(clk, f, min_steps, mode, "freq_hz does not match PSC/ARR");
+    if (r->err_ppm < ppm - 1.0 || r->err_ppm > ppm + 1.0)
+        fail(clk, f, min_steps, mode, "err_ppm does not match PSC/ARR");
+
+    /* within one duty step of the requested period */
+    if (ppm * r->steps > 1e6 || ppm * r->steps < -1e6)
+        fail(clk, f, min_steps, mode, "period off by more than one step");
+
+    return ppm < 0 ? -ppm : ppm;
+}
+
+static void sweep(uint32_t clk, uint16_t min_steps)
+{
+    double worst = 0;
+    uint32_t most_tries = 0;
+
+    for (uint32_t f = 1; f <= TEST_FMAX; f++)
+    {
+        PWM_Fit_t ex, res;
+        uint32_t  n = (clk + f / 2) / f;
+        uint32_t  p_min = (n + 0xFFFF) >> 16;
+        uint32_t  p_max = n / min_steps;
+        uint8_t   ok = (n >= min_steps);
+        double    e_ex, e_res;
+
+        if (HAL_PWM_Solve(clk, f, min_steps, PWM_FIT_EXACT, &ex) != ok ||
+            HAL_PWM_Solve(clk, f, min_steps, PWM_FIT_RESOLUTION, &res) != ok)
+        {
+            fail(clk, f, min_steps, PWM_FIT_EXACT, ok ? "no fit" : "fit below min_steps");
+            continue;
+        }
+        if (!ok)
+            continue;
+
+        e_ex  = check(clk, f, min_steps, PWM_FIT_EXACT, &ex);
+        e_res = check(clk, f, min_steps, PWM_FIT_RESOLUTION, &res);
+
+        /* RESOLUTION: smallest PSC, so the most steps */
+        if (res.psc != p_min - 1)
+            fail(clk, f, min_steps, PWM_FIT_RESOLUTION, "PSC is not the smallest");
+
+        /* EXACT is never worse than RESOLUTION */
+        if (e_ex > e_res + 1.0)
+            fail(clk, f, min_steps, PWM_FIT_EXACT, "worse than PWM_FIT_RESOLUTION");
+
+        /* EXACT: the smallest P dividing N, or RESOLUTION if none does */
+        if (p_max > 0x10000)
+            p_max = 0x10000;
+        if (n > 0x10000)
+        {
+            uint32_t p = brute_p(n, p_min, p_max);
+
+            if (p != 0 && (ex.psc + 1U != p || (uint64_t)p * ex.steps != n))
+                fail(clk, f, min_steps, PWM_FIT_EXACT, "not the smallest exact pair");
+            if (p == 0 && (ex.psc != res.psc || ex.arr != res.arr))
+                fail(clk, f, min_steps, PWM_FIT_EXACT, "no exact pair, but not RESOLUTION");
+        }
+
+        /* bounded search cost */
+        if (ex.tries > isqrt(n))
+            fail(clk, f, min_steps, PWM_FIT_EXACT, "more than sqrt(N) tries");
+        if (ex.tries > most_tries)
+            most_tries = ex.tries;
+
+        if (e_ex > worst)
+            worst = e_ex;
+    }
+
+    printf("%2lu MHz, min_steps %4u: worst EXACT error %5.0f ppm, most tries %lu\n",
+           (unsigned long)(clk / 1000000), min_steps, worst, (unsigned long)most_tries);
+}
+
+// Worst case for the search: N prime, so every d up to sqrt(N) fails
+static void prime_worst_case(void)
+{
+    const uint32_t clk = 23999999UL;            // prime
+    PWM_Fit_t r;
+
+    if (!HAL_PWM_Solve(clk, 1, 2, PWM_FIT_EXACT, &r))
+    {
+        fail(clk, 1, 2, PWM_FIT_EXACT, "no fit for prime N");
+        return;
+    }
+
+    check(clk, 1, 2, PWM_FIT_EXACT, &r);
+    if (r.tries > isqrt(clk))
+        fail(clk, 1, 2, PWM_FIT_EXACT, "prime N: more than sqrt(N) tries");
+
+    printf("prime N = %lu: %lu tries (sqrt(N) = %lu), error %ld ppm\n",
+           (unsigned long)clk, (unsigned long)r.tries,
+           (unsigned long)isqrt(clk), (long)r.err_ppm);
+}
+
+int main(void)
+{
+    sweep(24000000UL, 2);
+    sweep(24000000UL, 100);
+    sweep(24000000UL, 1000);
+    sweep(48000000UL, 2);
+    prime_worst_case();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures != 0;
+}
@@ -0,0 +1,10 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "driver_gpio_pin.h"
+
+/* Board pin map (VSDSquadron Mini), applied by HAL_GPIO_InitTable() */
+extern const GPIO_PinConfig_t board_pins[];
+extern const uint8_t board_pin_count;
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include "driver_gpio.h"
+#include "driver_pwm_tim.h"
+#include "driver_dma.h"
+#include "driver_pfic.h"
+
+/* Sample buffer (bytes); streaming uses the two halves alternately */
+#ifndef CAPTURE_BUF_SIZE
+#define CAPTURE_BUF_SIZE    256
+#endif
+
+/* Highest sample rate accepted by the 'capture' command */
+#define CAPTURE_MAX_RATE    1000000
+
+/* Runs printed per output line */
+#define CAPTURE_RUNS_PER_LINE   8
+
+// Register the 'capture' command (call after JOB_Init)
+void CAPTURE_Init(void);
+
+// Start sampling GPIOx->INDR at rate_hz (returns 1 if started)
+uint8_t CAPTURE_Start(GPIO_RegDef_t *port, uint32_t rate_hz, uint32_t samples);
+uint8_t CAPTURE_Busy(void);
+
+// TIM2 update → DMA1 channel 2 interrupt
+void DMA1_Channel2_IRQHandler(void) IRQ_HANDLER;
+
+#endif
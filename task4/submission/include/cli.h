@@ -3,17 +3,56 @@
 
 #include "driver_usart_debug.h"
 #include "driver_gpio.h"
+#include "driver_gpio_pin.h"
 #include "driver_rcc.h"
-#include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
-#include <stdio.h>
 
 /* LED CONFIG */
 #define LED_PORT GPIOD
 #define LED_PIN 4
+#define LED     PIN(D, 4)
+
+/* Limits */
+#define CLI_MAX_ARGS    8       // argv entries, command name included
+#define CLI_MAX_TABLES  4       // command tables that can be registered
+#define CLI_HASH_SIZE   64      // lookup slots, power of two
+
+// Command handler: argv[0] is the command name
+typedef void (*CLI_Handler_t)(uint8_t argc, char *argv[]);
+
+// One command table entry (tables are const and live in flash)
+typedef struct
+{
+    const char    *name;        // command word, lower case
+    const char    *args;        // argument spec for help/usage, e.g. "<ms> <count>"
+    uint8_t        min_args;    // arguments after the name
+    uint8_t        max_args;
+    CLI_Handler_t  handler;
+    const char    *help;        // one-line description
+} CLI_Command_t;
+
+// CLI_ParseInt() result codes
+typedef enum {
+    CLI_PARSE_OK = 0,
+    CLI_PARSE_EMPTY,        // no digits
+    CLI_PARSE_SYNTAX,       // invalid character for the base
+    CLI_PARSE_RANGE         // outside [min, max] or over 32 bits
+} CLI_ParseResult_t;
+
+// Register the built-in commands
+void CLI_Init(void);
+
+// Register a module's command table (returns 1 on success)
+uint8_t CLI_Register(const CLI_Command_t *table, uint8_t count);
 
 // Command Line Interface
 void CLI_Process(char *cmd);
 
+// Line input for protothreads: the console hands its next line over
+uint8_t CLI_TakeLine(char *buf, uint8_t maxLen);
+void CLI_Break(void);
+
+// Strict integer parsing for handlers: decimal, 0x hex, 0b binary
+CLI_ParseResult_t CLI_ParseInt(const char *s, int32_t min, int32_t max, int32_t *out);
+uint8_t CLI_ArgInt(const char *name, const char *s, int32_t min, int32_t max, int32_t *out);
+
 #endif
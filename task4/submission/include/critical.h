@@ -0,0 +1,79 @@
+#ifndef CRITICAL_H
+#define CRITICAL_H
+
+#include <stdint.h>
+#include "driver_pfic.h"
+
+/*
+ * Critical sections and interrupt timing.
+ *
+ *   uint32_t s = CRIT_ENTER();     // mask interrupts, remember state
+ *   ...
+ *   CRIT_EXIT(s);                  // restore the previous state
+ *
+ * Sections nest (the inner one restores "masked") and are usable in
+ * handlers. Handlers are timed by bracketing their body:
+ *
+ *   void X_IRQHandler(void) { IRQ_ENTER(); ...; IRQ_EXIT(IRQ_X); }
+ *
+ * Build with -DIRQ_STATS to record, from SysTick->CNT (core cycles):
+ *   - the longest span with interrupts masked and its call site
+ *     (outermost sections in thread context),
+ *   - min/max/average run time of every instrumented handler
+ *     (a nested handler's time counts in the one it interrupted).
+ * Without IRQ_STATS the macros are the bare mask/unmask instructions
+ * and the hooks are empty.
+ */
+
+#define MSTATUS_MIE     0x8
+
+#if defined(IRQ_STATS)
+#define IRQSTAT_MAX     8       // handlers that can be tracked
+#endif
+
+// Mask interrupts, return the previous mstatus
+static inline uint32_t crit_enter(void)
+{
+    uint32_t mstatus = 0;
+#if defined(__riscv)
+    __asm volatile ("csrrci %0, mstatus, 0x8" : "=r"(mstatus) :: "memory");
+#endif
+    return mstatus;
+}
+
+// Unmask interrupts if they were enabled at the matching crit_enter()
+static inline void crit_exit(uint32_t mstatus)
+{
+#if defined(__riscv)
+    if (mstatus & MSTATUS_MIE)
+        __asm volatile ("csrsi mstatus, 0x8" ::: "memory");
+#else
+    (void)mstatus;
+#endif
+}
+
+#if defined(IRQ_STATS)
+
+uint32_t crit_enter_stat(const char *file, uint16_t line);
+void crit_exit_stat(uint32_t mstatus);
+uint32_t irqstat_now(void);
+void irqstat_exit(IRQn_t irq, uint32_t t0);
+
+#define CRIT_ENTER()    crit_enter_stat(__FILE__, __LINE__)
+#define CRIT_EXIT(s)    crit_exit_stat(s)
+#define IRQ_ENTER()     uint32_t irqstat_t0_ = irqstat_now()
+#define IRQ_EXIT(irq)   irqstat_exit((irq), irqstat_t0_)
+
+#else
+
+#define CRIT_ENTER()    crit_enter()
+#define CRIT_EXIT(s)    crit_exit(s)
+#define IRQ_ENTER()     do { } while (0)
+#define IRQ_EXIT(irq)   do { } while (0)
+
+#endif
+
+// Register the 'irqstat' command (nothing without IRQ_STATS)
+void IRQSTAT_Init(void);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef DRIVER_DMA_H
+#define DRIVER_DMA_H
+
+#include <stdint.h>
+#include <driver_gpio.h>
+
+/* DMA1 Peripheral Base Address */
+#define DMA1_BASEADDR                           (AHBPERIPH_BASEADDR + 0x0000U)
+
+#define DMA1                                    ((DMA_RegDef_t *)DMA1_BASEADDR)
+
+/* RCC bits */
+#define RCC_DMA1EN      (1 << 0)    // AHBPCENR
+
+typedef struct
+{
+    // DMA Channel Registers
+    volatile uint32_t CFGR;
+    volatile uint32_t CNTR;
+    volatile uint32_t PADDR;
+    volatile uint32_t MADDR;
+    uint32_t RESERVED0;
+} DMA_Channel_RegDef_t;
+
+typedef struct
+{
+    // DMA Registers
+    volatile uint32_t INTFR;
+    volatile uint32_t INTFCR;
+    DMA_Channel_RegDef_t CH[7];     // CH[0] = channel 1
+} DMA_RegDef_t;
+
+/* Channel number (1-7) → channel registers */
+#define DMA1_CH(n)      (&DMA1->CH[(n) - 1])
+
+/* Request mapping used by the drivers (CH32V003 RM, DMA1 table) */
+#define DMA_CH_TIM2_UP      2
+#define DMA_CH_USART1_TX    4
+#define DMA_CH_USART1_RX    5
+#define DMA_CH_TIM1_UP      5       // shared with USART1_RX (RX uses IRQs)
+
+/* CFGR bits */
+#define DMA_CFGR_EN         (1 << 0)
+#define DMA_CFGR_TCIE       (1 << 1)
+#define DMA_CFGR_HTIE       (1 << 2)
+#define DMA_CFGR_TEIE       (1 << 3)
+#define DMA_CFGR_DIR        (1 << 4)    // 1 = memory → peripheral
+#define DMA_CFGR_CIRC       (1 << 5)
+#define DMA_CFGR_PINC       (1 << 6)
+#define DMA_CFGR_MINC       (1 << 7)
+#define DMA_CFGR_PSIZE_8    (0 << 8)
+#define DMA_CFGR_PSIZE_16   (1 << 8)
+#define DMA_CFGR_PSIZE_32   (2 << 8)
+#define DMA_CFGR_MSIZE_8    (0 << 10)
+#define DMA_CFGR_MSIZE_16   (1 << 10)
+#define DMA_CFGR_MSIZE_32   (2 << 10)
+#define DMA_CFGR_PL_LOW     (0 << 12)
+#define DMA_CFGR_PL_MEDIUM  (1 << 12)
+#define DMA_CFGR_PL_HIGH    (2 << 12)
+#define DMA_CFGR_PL_VHIGH   (3 << 12)
+#define DMA_CFGR_MEM2MEM    (1 << 14)
+
+/* INTFR / INTFCR flags for channel n (1-7) */
+#define DMA_GIF(n)          (1U << (((n) - 1) * 4))
+#define DMA_TCIF(n)         (2U << (((n) - 1) * 4))
+#define DMA_HTIF(n)         (4U << (((n) - 1) * 4))
+#define DMA_TEIF(n)         (8U << (((n) - 1) * 4))
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DRIVER_EXTI_H
+#define DRIVER_EXTI_H
+
+#include <stdint.h>
+#include "driver_gpio_pin.h"
+#include "driver_rcc.h"
+#include "driver_pfic.h"
+
+/* AFIO / EXTI Peripheral Base Addresses */
+#define AFIO_BASEADDR                           (APB2PERIPH_BASEADDR + 0x0000U)
+#define EXTI_BASEADDR                           (APB2PERIPH_BASEADDR + 0x0400U)
+
+#define AFIO                                    ((AFIO_RegDef_t *)AFIO_BASEADDR)
+#define EXTI                                    ((EXTI_RegDef_t *)EXTI_BASEADDR)
+
+typedef struct
+{
+    // AFIO Registers
+    uint32_t RESERVED0;
+    volatile uint32_t PCFR1;
+    volatile uint32_t EXTICR;       // 2 bits per line: 00 PA, 10 PC, 11 PD
+} AFIO_RegDef_t;
+
+typedef struct
+{
+    // EXTI Registers
+    volatile uint32_t INTENR;
+    volatile uint32_t EVENR;
+    volatile uint32_t RTENR;
+    volatile uint32_t FTENR;
+    volatile uint32_t SWIEVR;
+    volatile uint32_t INTFR;
+} EXTI_RegDef_t;
+
+/* Number of GPIO lines (EXTI line n = pin n of the selected port) */
+#define EXTI_LINES      8
+
+// Edge selection
+typedef enum {
+    EXTI_EDGE_RISING  = 1,
+    EXTI_EDGE_FALLING = 2,
+    EXTI_EDGE_BOTH    = 3
+} EXTI_Edge_t;
+
+// Edge callback (interrupt context): line number and new pin level
+typedef void (*EXTI_Callback_t)(uint8_t line, uint8_t level);
+
+// Attach an edge interrupt to a pin (returns 1 on success)
+uint8_t HAL_EXTI_Attach(GPIO_Pin_t pin, EXTI_Edge_t edge,
+                        EXTI_Callback_t cb, uint16_t debounce_ms);
+void HAL_EXTI_Detach(uint8_t line);
+
+// Per-line statistics
+uint32_t HAL_EXTI_GetCount(uint8_t line);
+uint32_t HAL_EXTI_GetLastTime(uint8_t line);
+
+// EXTI lines 0-7 interrupt
+void EXTI7_0_IRQHandler(void) IRQ_HANDLER;
+
+#endif
@@ -49,7 +49,12 @@ typedef enum {
     GPIO_CNF_PUSH_PULL = 0,
     GPIO_CNF_OPEN_DRAIN,
     GPIO_CNF_AF_PUSH_PULL,
-    GPIO_CNF_AF_OPEN_DRAIN
+    GPIO_CNF_AF_OPEN_DRAIN,
+
+    // Same CNF values when mode is GPIO_MODE_INPUT
+    GPIO_CNF_IN_ANALOG = 0,
+    GPIO_CNF_IN_FLOATING,
+    GPIO_CNF_IN_PULL            // pull-up/down chosen by OUTDR
 } GPIO_CNF_t;
 
 // Initialize a single GPIO pin
@@ -64,5 +69,11 @@ void HAL_GPIO_TogglePin(GPIO_RegDef_t *GPIOx, uint8_t pin);
 // Read pin (returns 0 or 1)
 uint8_t HAL_GPIO_ReadPin(GPIO_RegDef_t *GPIOx, uint8_t pin);
 
+// Set/clear several pins in one atomic write (bit n = pin n)
+void HAL_GPIO_WritePort(GPIO_RegDef_t *GPIOx, uint16_t setMask, uint16_t clearMask);
+
+// Read all pins of a port (bit n = pin n)
+uint16_t HAL_GPIO_ReadPort(GPIO_RegDef_t *GPIOx);
+
 #endif //__CH32V00x_GPIO_H
 
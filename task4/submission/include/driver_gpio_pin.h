@@ -0,0 +1,88 @@
+#ifndef DRIVER_GPIO_PIN_H
+#define DRIVER_GPIO_PIN_H
+
+#include <stdint.h>
+#include <driver_gpio.h>
+
+/*
+ * Compile-time pin descriptors.
+ *
+ *   #define LED  PIN(D, 4)
+ *   pin_set(LED);                 → one store to GPIOD->BSHR
+ *
+ * With a constant descriptor every helper below inlines to a single
+ * load or store (port address and mask fold to constants). PIN()
+ * rejects pins that do not exist on the CH32V003 at compile time.
+ */
+
+/* Pins bonded out per port (bit n = pin n) */
+#define GPIO_VALID_PINS_A   0x06    // PA1, PA2
+#define GPIO_VALID_PINS_C   0xFF    // PC0-PC7
+#define GPIO_VALID_PINS_D   0xFF    // PD0-PD7
+
+typedef struct
+{
+    GPIO_RegDef_t *port;
+    uint8_t        pin;
+} GPIO_Pin_t;
+
+/* Checked descriptor: PIN(D, 4); invalid port or pin fails to compile */
+#define PIN(port, n)                                                        \
+    ((GPIO_Pin_t){ GPIO##port, (n) + 0 * sizeof(struct {                   \
+        _Static_assert(((GPIO_VALID_PINS_##port) >> (n)) & 1,             \
+                       "PIN(" #port ", " #n "): no such pin");           \
+        char c; }) })
+
+/* Unchecked descriptor from run-time values (used by HAL_GPIO_*) */
+#define PIN_RT(GPIOx, n)    ((GPIO_Pin_t){ (GPIOx), (n) })
+
+/* Drive pin HIGH (BSHR) */
+static inline void pin_set(GPIO_Pin_t p)
+{
+    p.port->BSHR = (1U << p.pin);
+}
+
+/* Drive pin LOW (BCR) */
+static inline void pin_clr(GPIO_Pin_t p)
+{
+    p.port->BCR = (1U << p.pin);
+}
+
+/* Drive pin to 'state' (0 = LOW, otherwise HIGH) */
+static inline void pin_write(GPIO_Pin_t p, uint8_t state)
+{
+    if (state)
+        pin_set(p);
+    else
+        pin_clr(p);
+}
+
+/* Invert the output latch (one OUTDR read, one BSHR store) */
+static inline void pin_toggle(GPIO_Pin_t p)
+{
+    uint32_t mask = (1U << p.pin);
+
+    p.port->BSHR = (p.port->OUTDR & mask) ? (mask << 16) : mask;
+}
+
+/* Input level (0 or 1) */
+static inline uint8_t pin_read(GPIO_Pin_t p)
+{
+    return (p.port->INDR >> p.pin) & 0x1;
+}
+
+/* ================= BATCH CONFIGURATION ================= */
+
+// One row of a board pin map
+typedef struct
+{
+    GPIO_Pin_t  pin;            // PIN(port, n)
+    GPIO_Mode_t mode;
+    GPIO_CNF_t  cnf;
+    uint8_t     level;          // initial output level, or 1 = pull-up for GPIO_CNF_IN_PULL
+} GPIO_PinConfig_t;
+
+// Apply a pin map: one APB2PCENR write, one BSHR and one CFGLR write per port
+void HAL_GPIO_InitTable(const GPIO_PinConfig_t *table, uint8_t count);
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef DRIVER_PFIC_H
+#define DRIVER_PFIC_H
+
+#include <stdint.h>
+
+/* Programmable Fast Interrupt Controller (QingKe V2A core) */
+#define PFIC_BASEADDR                           (0xE000E000U)
+
+#define PFIC                                    ((PFIC_RegDef_t *)PFIC_BASEADDR)
+
+typedef struct
+{
+    // PFIC Registers
+    volatile uint32_t ISR[8];
+    volatile uint32_t IPR[8];
+    volatile uint32_t ITHRESDR;
+    uint32_t RESERVED0;
+    volatile uint32_t CFGR;
+    volatile uint32_t GISR;
+    volatile uint8_t  VTFIDR[4];
+    uint8_t  RESERVED1[12];
+    volatile uint32_t VTFADDR[4];
+    uint8_t  RESERVED2[0x90];
+    volatile uint32_t IENR[8];
+    uint8_t  RESERVED3[0x60];
+    volatile uint32_t IRER[8];
+    uint8_t  RESERVED4[0x60];
+    volatile uint32_t IPSR[8];
+    uint8_t  RESERVED5[0x60];
+    volatile uint32_t IPRR[8];
+    uint8_t  RESERVED6[0x60];
+    volatile uint32_t IACTR[8];
+    uint8_t  RESERVED7[0xE0];
+    volatile uint8_t  IPRIOR[256];
+    uint8_t  RESERVED8[0x810];
+    volatile uint32_t SCTLR;
+} PFIC_RegDef_t;
+
+// Interrupt numbers (CH32V003 vector table positions)
+typedef enum {
+    IRQ_SYSTICK     = 12,
+    IRQ_SW          = 14,
+    IRQ_EXTI7_0     = 20,
+    IRQ_DMA1_CH1    = 22,
+    IRQ_DMA1_CH2    = 23,
+    IRQ_DMA1_CH3    = 24,
+    IRQ_DMA1_CH4    = 25,
+    IRQ_DMA1_CH5    = 26,
+    IRQ_DMA1_CH6    = 27,
+    IRQ_DMA1_CH7    = 28,
+    IRQ_USART1      = 32,
+    IRQ_TIM1_UP     = 35,
+    IRQ_TIM2        = 38,
+} IRQn_t;
+
+/*
+ * Interrupt handler attribute (plain C function on host builds).
+ * Define PFIC_FAST_HANDLERS (WCH GCC only) when HPE is enabled from
+ * start-up: handlers then skip the software register save and rely on
+ * the hardware prologue. Without it handlers are always safe, HPE or not.
+ */
+#if defined(__riscv) && defined(PFIC_FAST_HANDLERS)
+#define IRQ_HANDLER __attribute__((interrupt("WCH-Interrupt-fast")))
+#elif defined(__riscv)
+#define IRQ_HANDLER __attribute__((interrupt))
+#else
+#define IRQ_HANDLER
+#endif
+
+/* HAL_PFIC_Config() flags (INTSYSCR, CSR 0x804) */
+#define PFIC_HPE            0x01    // hardware prologue/epilogue (HWSTKEN)
+#define PFIC_NEST           0x02    // interrupt nesting (INESTEN)
+
+/*
+ * Priorities (IPRIOR bits 7:6), 0 = highest. With PFIC_NEST the upper
+ * bit is the preemption level: 0-1 can interrupt handlers of 2-3.
+ */
+#define PFIC_PRIO_HIGHEST   0
+#define PFIC_PRIO_LOWEST    3
+
+/* Vector-table-free fast interrupt slots (QingKe V2A) */
+#define PFIC_VTF_SLOTS      2
+
+// Enable/Disable a peripheral interrupt in the PFIC
+void HAL_PFIC_EnableIRQ(IRQn_t irq);
+void HAL_PFIC_DisableIRQ(IRQn_t irq);
+
+// Priority, software trigger
+void HAL_PFIC_SetPriority(IRQn_t irq, uint8_t prio);
+void HAL_PFIC_SetPending(IRQn_t irq);
+
+// Core interrupt features: PFIC_HPE | PFIC_NEST
+void HAL_PFIC_Config(uint8_t flags);
+
+// Vector-table-free slots (handler address goes straight to the PFIC)
+uint8_t HAL_PFIC_SetVTF(uint8_t slot, IRQn_t irq, void (*handler)(void));
+void HAL_PFIC_ClearVTF(uint8_t slot);
+
+// Entry latency of the software interrupt in core cycles
+uint32_t HAL_PFIC_MeasureLatency(uint8_t use_vtf);
+
+// Software interrupt (used by the latency measurement)
+void SW_Handler(void) IRQ_HANDLER;
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef DRIVER_PWM_H
+#define DRIVER_PWM_H
+
+#include <stdint.h>
+#include "driver_gpio.h"
+#include "driver_rcc.h"
+#include "system_ch32v00x.h"
+
+/*
+ * TIM1/TIM2 register access for the DMA pacing users (capture,
+ * pattern). The full PWM driver lives in task3.
+ */
+#define TIM1_BASEADDR                               (APB2PERIPH_BASEADDR + 0x2C00)
+#define TIM2_BASEADDR                               (APB1PERIPH_BASEADDR + 0x0000)
+#define TIM2                                        ((TIM_RegDef_t *)TIM2_BASEADDR)
+#define TIM1                                        ((TIM_RegDef_t *)TIM1_BASEADDR)
+
+
+/* TIM Registers */
+typedef struct
+{
+    volatile uint16_t CTLR1;
+    uint16_t      RESERVED0;
+    volatile uint16_t CTLR2;
+    uint16_t      RESERVED1;
+    volatile uint16_t SMCFGR;
+    uint16_t      RESERVED2;
+    volatile uint16_t DMAINTENR;
+    uint16_t      RESERVED3;
+    volatile uint16_t INTFR;
+    uint16_t      RESERVED4;
+    volatile uint16_t SWEVGR;
+    uint16_t      RESERVED5;
+    volatile uint16_t CHCTLR1;
+    uint16_t      RESERVED6;
+    volatile uint16_t CHCTLR2;
+    uint16_t      RESERVED7;
+    volatile uint16_t CCER;
+    uint16_t      RESERVED8;
+    volatile uint16_t CNT;
+    uint16_t      RESERVED9;
+    volatile uint16_t PSC;
+    uint16_t      RESERVED10;
+    volatile uint16_t ATRLR;
+    uint16_t      RESERVED11;
+    volatile uint16_t RPTCR;
+    uint16_t      RESERVED12;
+    volatile uint32_t CH1CVR;
+    volatile uint32_t CH2CVR;
+    volatile uint32_t CH3CVR;
+    volatile uint32_t CH4CVR;
+    volatile uint16_t BDTR;
+    uint16_t      RESERVED13;
+    volatile uint16_t DMACFGR;
+    uint16_t      RESERVED14;
+    volatile uint16_t DMAADR;
+    uint16_t      RESERVED15;
+} TIM_RegDef_t;
+
+/* RCC bits */
+#define RCC_TIM1EN          (1 << 11)   // APB2PCENR
+#define RCC_TIM2EN          (1 << 0)    // APB1PCENR
+
+/* TIM bits */
+#define TIM_CTLR1_CEN       (1 << 0)
+#define TIM_CTLR1_ARPE      (1 << 7)
+#define TIM_DMAINTENR_UDE   (1 << 8)    // DMA request on update event
+#define TIM_SWEVGR_UG       (1 << 0)
+
+// Set PSC/ARR for an update event rate (timer stopped, clock enabled)
+void HAL_TIM_SetUpdateRate(TIM_RegDef_t *TIMx, uint32_t rate_hz);
+
+#endif
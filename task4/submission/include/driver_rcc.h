@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <driver_gpio.h>
+#include "driver_pfic.h"
 #include "system_ch32v00x.h"
 
 /* APB2_peripheral */
@@ -59,14 +60,53 @@ typedef struct
     uint32_t RESERVED1;
 }SysTick_RegDef_t;
 
+/* SysTick CTLR bits */
+#define SYSTICK_STE     (1 << 0)    // counter enable
+#define SYSTICK_STIE    (1 << 1)    // interrupt enable
+#define SYSTICK_STCLK   (1 << 2)    // 1 = HCLK, 0 = HCLK/8
+#define SYSTICK_STRE    (1 << 3)    // reload to 0 on compare match
+
+/* SysTick SR bits */
+#define SYSTICK_CNTIF   (1 << 0)
+
 // Enable/Disable APB2 peripheral clock
 void HAL_RCC_APB2_Enable(RCC_APB2Periph_t periph);
 void HAL_RCC_APB2_Disable(RCC_APB2Periph_t periph);
 
+/* Functions run from SysTick_Handler every 1ms */
+#define TICK_HOOK_MAX   4
+
+typedef void (*HAL_TickHook_t)(void);
+
 // Delay 
-void SysTick_Handler(void);
+void SysTick_Handler(void) IRQ_HANDLER;
+uint8_t HAL_Tick_AddHook(HAL_TickHook_t fn);
 void HAL_Delay_Init(void);
+uint32_t HAL_GetTick(void);
+uint64_t HAL_GetMicros(void);
+uint32_t HAL_GetCycles(void);
+uint32_t HAL_CyclesToMicros(uint32_t cycles);
 void HAL_Delay_us(uint32_t us);
 void HAL_Delay_ms(uint32_t ms);
 
+/*
+ * HAL_Delay_Cycles
+ *  Busy-waits at least 'cycles' HCLK cycles (cycles < one SysTick
+ *  period, i.e. 1ms). Inline so the call itself adds nothing; the
+ *  resolution is one polling pass of SysTick->CNT (a few cycles).
+ */
+static inline void HAL_Delay_Cycles(uint32_t cycles)
+{
+    uint32_t start = SysTick->CNT;
+    uint32_t period = SysTick->CMP + 1;
+    uint32_t now;
+
+    do
+    {
+        now = SysTick->CNT;
+        if (now < start)
+            now += period;
+    } while ((now - start) < cycles);
+}
+
 #endif
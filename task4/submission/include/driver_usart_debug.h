@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <driver_gpio.h>
 #include <driver_rcc.h>
+#include <driver_pfic.h>
+#include <driver_dma.h>
 
 /* ================= REGISTER DEFINITIONS ================= */
 
@@ -30,7 +32,13 @@ typedef struct
     uint16_t RESERVED6;
 } USART_RegDef_t;
 
+/* Host builds (-DUART_HOST_SIM) use a simulated register block in RAM */
+#if defined(UART_HOST_SIM)
+extern USART_RegDef_t USART1_Sim;
+#define USART1 (&USART1_Sim)
+#else
 #define USART1 ((USART_RegDef_t*)USART1_BASE)
+#endif
 
 /* RCC bits */
 #define RCC_IOPDEN   (1 << 5)
@@ -38,12 +46,54 @@ typedef struct
 
 /* USART flags */
 #define USART_TXE    (1 << 7)
+#define USART_TC     (1 << 6)
+#define USART_RXNE   (1 << 5)
+#define USART_IDLE   (1 << 4)
+#define USART_ORE    (1 << 3)
 #define USART_UE     (1 << 13)
 #define USART_TE     (1 << 3)
+#define USART_TXEIE  (1 << 7)
+#define USART_RXNEIE (1 << 5)
+#define USART_IDLEIE (1 << 4)
+#define USART_DMAT   (1 << 7)   // CTLR3
 
 /* special value → print string only */
 #define UART_NO_NUMBER  -1
 
+/* HAL_UART_PrintNum() flags */
+#define UART_FMT_ZERO       0x01    // pad with '0' instead of ' '
+#define UART_FMT_UNSIGNED   0x02    // treat val as uint32_t
+
+/* ================= TX RING BUFFER ================= */
+
+/* TX buffer size in bytes, must be a power of two */
+#ifndef UART_TX_BUF_SIZE
+#define UART_TX_BUF_SIZE  128
+#endif
+
+/* HAL_UART_TryReadLine() results */
+#define UART_LINE_NONE      0
+#define UART_LINE_READY     1   // ENTER completed a line
+#define UART_LINE_BREAK     2   // Ctrl-C pressed, line discarded
+
+/* RX buffer size in bytes, must be a power of two */
+#ifndef UART_RX_BUF_SIZE
+#define UART_RX_BUF_SIZE  128
+#endif
+
+// What to do when the TX buffer cannot hold the data
+typedef enum {
+    UART_TX_BLOCK = 0,      // wait until the ISR frees space
+    UART_TX_DROP,           // discard the whole string if it does not fit
+    UART_TX_TRUNCATE        // send what fits, discard the rest
+} UART_TxPolicy_t;
+
+// Called from the DMA ISR when a HAL_UART_SendBuffer() transfer ends
+typedef void (*UART_TxDoneCallback_t)(void);
+
+// Called from the USART1 ISR after a byte was stored or the line went idle
+typedef void (*UART_RxCallback_t)(void);
+
 
 void HAL_UART_Init(void);
 void HAL_UART_SendChar(char c);
@@ -51,6 +101,31 @@ char HAL_UART_ReadChar(void);
 void HAL_UART_SendString(const char *s);
 void HAL_UART_ReadLine(char *buf, uint8_t maxLen);
 
+// Non-blocking RX (interrupt-fed RX buffer)
+uint16_t HAL_UART_Available(void);
+uint8_t HAL_UART_TryReadChar(char *c);
+uint8_t HAL_UART_TryReadLine(char *buf, uint8_t maxLen);
+uint8_t HAL_UART_RxIdle(void);
+uint32_t HAL_UART_GetRxDropped(void);
+void HAL_UART_SetRxCallback(UART_RxCallback_t cb);
+
+// TX buffer control
+void HAL_UART_SetTxPolicy(UART_TxPolicy_t policy);
+void HAL_UART_Flush(void);
+uint32_t HAL_UART_GetDropped(void);
+
+// Bulk transmit via DMA1 channel 4 (returns 1 if started, 0 if busy)
+uint8_t HAL_UART_SendBuffer(const uint8_t *buf, uint16_t len);
+uint8_t HAL_UART_SendStringDMA(const char *s);
+uint8_t HAL_UART_TxBusy(void);
+void HAL_UART_SetTxDoneCallback(UART_TxDoneCallback_t cb);
+
+// USART1 interrupt (TXE drains the TX buffer, RXNE/IDLE fill the RX buffer)
+void USART1_IRQHandler(void) IRQ_HANDLER;
+
+// DMA1 channel 4 interrupt (USART1_TX transfer complete)
+void DMA1_Channel4_IRQHandler(void) IRQ_HANDLER;
+
 /*
  * UART_Print
  *  str  : string to print
@@ -59,6 +134,13 @@ void HAL_UART_ReadLine(char *buf, uint8_t maxLen);
  */
 void HAL_UART_Print(const char *str, int32_t val, uint8_t base);
 
+// Division-free number output: fixed width/zero padding, fixed-point
+void HAL_UART_PrintNum(int32_t val, uint8_t base, uint8_t width, uint8_t flags);
+void HAL_UART_PrintFixed(int32_t val, uint8_t decimals, uint8_t width);
+
+// Minimal printf: %d %u %x %X %s %c %% with '0' flag and width
+void HAL_UART_Printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
 #endif /* __CH32V00x_USART_DEBUG_H */
 
 
@@ -0,0 +1,52 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdint.h>
+#include "pt.h"
+
+/* Maximum number of background jobs */
+#define JOB_MAX     4
+
+typedef struct JOB JOB_t;
+
+// Job step: called every period_ms, returns 0 when the job is finished.
+// A protothread on job->pt can be used as a step (PT_ENDED == 0).
+typedef uint8_t (*JOB_Step_t)(JOB_t *job);
+
+// Called when a running job is killed (not when it finishes by itself);
+// releases hardware the job owns
+typedef void (*JOB_KillHook_t)(JOB_t *job);
+
+struct JOB
+{
+    const char *name;
+    JOB_Step_t  step;
+    JOB_KillHook_t on_kill; // optional, see JOB_SetKillHook()
+    uint32_t    period_ms;
+    uint32_t    next_ms;
+    int32_t     data[2];    // job-private state (e.g. remaining count)
+    PT_t        pt;         // protothread state for PT_THREAD steps
+    uint8_t     id;         // 0 = free slot
+};
+
+// Initialize job pool and register the 'jobs' and 'kill' commands
+void JOB_Init(void);
+
+// Start a job (returns its id, 0 if the pool is full)
+uint8_t JOB_Start(const char *name, JOB_Step_t step, uint32_t period_ms,
+                  int32_t d0, int32_t d1);
+
+// Install a cleanup hook for a running job (returns 0 if no such job)
+uint8_t JOB_SetKillHook(uint8_t id, JOB_KillHook_t hook);
+
+// Stop jobs (runs their kill hooks)
+uint8_t JOB_Kill(uint8_t id);
+void JOB_KillAll(void);
+
+// Check whether a job is still running
+uint8_t JOB_Running(uint8_t id);
+
+// Run the steps that are due; call from the super-loop
+void JOB_Poll(void);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <stdint.h>
+#include "driver_gpio.h"
+#include "driver_pwm_tim.h"
+#include "driver_dma.h"
+#include "driver_pfic.h"
+
+/* Output modes */
+typedef enum {
+    PATTERN_ONESHOT = 0,    // play the table once, pins keep the last step
+    PATTERN_CIRCULAR        // repeat until PATTERN_Stop()
+} PATTERN_Mode_t;
+
+// One pin and its bit stream (bit n = level at step n, LSB first)
+typedef struct
+{
+    uint8_t        pin;     // 0-7 on the output port
+    const uint8_t *bits;
+} PATTERN_Stream_t;
+
+// Called from the DMA interrupt when a one-shot pattern has finished
+typedef void (*PATTERN_DoneCallback_t)(void);
+
+// Build BSHR words (one per step) from per-pin bit streams
+void PATTERN_Build(uint32_t *words, uint16_t steps,
+                   const PATTERN_Stream_t *streams, uint8_t count);
+
+// Replay a BSHR word table on a port at rate_hz (returns 1 if started)
+uint8_t PATTERN_Start(GPIO_RegDef_t *port, const uint32_t *words,
+                      uint16_t steps, uint32_t rate_hz, PATTERN_Mode_t mode);
+void PATTERN_Stop(void);
+uint8_t PATTERN_Busy(void);
+void PATTERN_SetDoneCallback(PATTERN_DoneCallback_t cb);
+
+// TIM1 update → DMA1 channel 5 interrupt
+void DMA1_Channel5_IRQHandler(void) IRQ_HANDLER;
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef PT_H
+#define PT_H
+
+#include <stdint.h>
+#include "driver_rcc.h"
+#include "driver_usart_debug.h"
+#include "cli.h"
+
+/*
+ * Protothreads: stackless coroutines built on a switch statement.
+ * A protothread is a function that returns at every wait and, when
+ * called again, jumps back to where it left off (the line number is
+ * kept in pt->lc). All threads share the caller's stack.
+ *
+ * RAM cost: one PT_t (8 bytes: 2-byte continuation, 4-byte wake-up
+ * time, padding) per protothread; nothing else.
+ *
+ * Rules:
+ *   - Local variables are lost at every wait; keep state in static
+ *     variables or in the structure that holds the PT_t.
+ *   - Do not use switch statements in the body (PT_BEGIN is one).
+ *   - At most one wait (PT_WAIT_*, PT_YIELD, PT_DELAY_MS, ...) per
+ *     source line; the line number is the resume point.
+ *   - Call the thread repeatedly (e.g. as a job step) until it
+ *     returns PT_ENDED.
+ *
+ * Example, run as a job (jobs call their step every 1 ms):
+ *
+ *   static PT_THREAD(demo(JOB_t *job))
+ *   {
+ *       static char line[32];
+ *       static uint8_t n, res;
+ *
+ *       PT_BEGIN(&job->pt);
+ *       PT_UART_READLINE(&job->pt, line, sizeof(line), res);
+ *       for (n = 0; n < 6; n++)
+ *       {
+ *           pin_toggle(LED);
+ *           PT_DELAY_MS(&job->pt, 100);
+ *       }
+ *       PT_DELAY_MS(&job->pt, 500);
+ *       HAL_UART_Printf("got '%s'\r\n", line);
+ *       PT_END(&job->pt);
+ *   }
+ */
+
+/* The resume labels are meant to be fallen into */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define PT_FALLTHROUGH          __attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH          ((void)0)
+#endif
+
+typedef struct
+{
+    uint16_t lc;            // local continuation (0 = start)
+    uint32_t wake;          // PT_DELAY_MS deadline (HAL_GetTick)
+} PT_t;
+
+/* Thread return values; PT_ENDED is 0 so a thread can be a job step */
+#define PT_ENDED        0
+#define PT_WAITING      1
+#define PT_YIELDED      2
+
+#define PT_THREAD(name_args)    uint8_t name_args
+
+#define PT_INIT(pt)             ((pt)->lc = 0)
+
+#define PT_BEGIN(pt)            { uint8_t pt_yielded = 1; (void)pt_yielded; \
+                                  switch ((pt)->lc) { case 0:
+
+#define PT_END(pt)              } PT_INIT(pt); return PT_ENDED; }
+
+// Wait (return to the caller) until cond is true
+#define PT_WAIT_UNTIL(pt, cond)         \
+    do {                                \
+        (pt)->lc = __LINE__;            \
+        PT_FALLTHROUGH;                 \
+        case __LINE__:                  \
+        if (!(cond))                    \
+            return PT_WAITING;          \
+    } while (0)
+
+#define PT_WAIT_WHILE(pt, cond)     PT_WAIT_UNTIL(pt, !(cond))
+
+// Give other work one turn
+#define PT_YIELD(pt)                    \
+    do {                                \
+        pt_yielded = 0;                 \
+        (pt)->lc = __LINE__;            \
+        PT_FALLTHROUGH;                 \
+        case __LINE__:                  \
+        if (!pt_yielded)                \
+            return PT_YIELDED;          \
+    } while (0)
+
+// Run a child protothread until it ends
+#define PT_WAIT_THREAD(pt, thread)  PT_WAIT_WHILE(pt, (thread) != PT_ENDED)
+
+// Leave the thread (restarts from PT_BEGIN on the next call)
+#define PT_EXIT(pt)                     \
+    do {                                \
+        PT_INIT(pt);                    \
+        return PT_ENDED;                \
+    } while (0)
+
+/* ---- Async driver calls ---- */
+
+// Non-blocking HAL_Delay_ms(): wait ms milliseconds (wrap-safe)
+#define PT_DELAY_MS(pt, ms)                                             \
+    do {                                                                \
+        (pt)->wake = HAL_GetTick() + (ms);                              \
+        PT_WAIT_UNTIL(pt, (int32_t)(HAL_GetTick() - (pt)->wake) >= 0);  \
+    } while (0)
+
+// Non-blocking HAL_UART_ReadLine(): res = UART_LINE_READY or _BREAK.
+// The console keeps reading the UART and hands its next line to buf
+// (CLI_TakeLine), so commands typed meanwhile are the thread's input.
+#define PT_UART_READLINE(pt, buf, len, res) \
+    PT_WAIT_UNTIL(pt, ((res) = CLI_TakeLine((buf), (len))) != UART_LINE_NONE)
+
+// Wait until a DMA transmit (HAL_UART_SendBuffer) has finished
+#define PT_UART_WAIT_TX(pt)         PT_WAIT_WHILE(pt, HAL_UART_TxBusy())
+
+#endif
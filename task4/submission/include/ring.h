@@ -0,0 +1,189 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lock-free single-producer / single-consumer byte ring.
+ *
+ * One side (e.g. an ISR) only calls the producer functions, the other
+ * (e.g. the main loop) only the consumer functions; no interrupt masking
+ * is needed. Same scheme as the UART buffers: free-running 16-bit
+ * indices, the producer owns head and the consumer owns tail, and
+ * (head - tail) is the fill level. The size must be a power of two
+ * (at most 32768) so indices wrap with a mask.
+ *
+ * Ordering: data is written before head is published (release) and
+ * read only after head has been loaded (acquire); the same holds for
+ * tail in the other direction. On the single-core CH32V003 the fences
+ * mainly keep the compiler from reordering; they also make the ring
+ * correct on hosts with real threads.
+ *
+ * Zero-copy access:
+ *   producer: n = ring_reserve(r, &p); fill p[0..n); ring_publish(r, k)
+ *   consumer: n = ring_peek(r, &p);    use  p[0..n); ring_commit(r, k)
+ * Both return the contiguous part only; call again after a wrap.
+ */
+
+#if defined(__riscv)
+#define RING_ACQUIRE()  __asm volatile ("fence r, rw" ::: "memory")
+#define RING_RELEASE()  __asm volatile ("fence rw, w" ::: "memory")
+#else
+#define RING_ACQUIRE()  __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define RING_RELEASE()  __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+typedef struct
+{
+    volatile uint16_t head;     // next write position (producer)
+    volatile uint16_t tail;     // next read position (consumer)
+    uint16_t          mask;     // size - 1
+    uint8_t          *buf;
+} RING_t;
+
+// Define a static ring with its storage; size must be a power of two
+#define RING_STATIC(name, size)                                             \
+    _Static_assert((size) > 0 && (size) <= 32768 &&                         \
+                   ((size) & ((size) - 1)) == 0,                            \
+                   #name ": ring size must be a power of two <= 32768");    \
+    static uint8_t name##_storage[size];                                    \
+    static RING_t name = { 0, 0, (size) - 1, name##_storage }
+
+/* ---- Either side ---- */
+
+// Bytes waiting to be read
+static inline uint16_t ring_count(const RING_t *r)
+{
+    return (uint16_t)(r->head - r->tail);
+}
+
+// Bytes that can still be written
+static inline uint16_t ring_space(const RING_t *r)
+{
+    return (uint16_t)(r->mask + 1 - ring_count(r));
+}
+
+/* ---- Producer side ---- */
+
+// Push one byte (returns 0 if full)
+static inline uint8_t ring_push(RING_t *r, uint8_t b)
+{
+    uint16_t head = r->head;
+
+    if ((uint16_t)(head - r->tail) > r->mask)
+        return 0;
+
+    RING_ACQUIRE();                 // slot was freed before we reuse it
+    r->buf[head & r->mask] = b;
+    RING_RELEASE();                 // data before head
+    r->head = head + 1;
+    return 1;
+}
+
+// Contiguous free space starting at the write position
+static inline uint16_t ring_reserve(RING_t *r, uint8_t **p)
+{
+    uint16_t head = r->head;
+    uint16_t space = (uint16_t)(r->mask + 1 - (uint16_t)(head - r->tail));
+    uint16_t to_end = (uint16_t)(r->mask + 1 - (head & r->mask));
+
+    RING_ACQUIRE();
+    *p = &r->buf[head & r->mask];
+    return space < to_end ? space : to_end;
+}
+
+// Make n reserved bytes visible to the consumer
+static inline void ring_publish(RING_t *r, uint16_t n)
+{
+    RING_RELEASE();
+    r->head = r->head + n;
+}
+
+// Push up to n bytes (returns how many were written)
+static inline uint16_t ring_push_bulk(RING_t *r, const uint8_t *src, uint16_t n)
+{
+    uint16_t done = 0;
+
+    while (done < n)
+    {
+        uint8_t *p;
+        uint16_t k = ring_reserve(r, &p);
+
+        if (k == 0)
+            break;
+        if (k > n - done)
+            k = n - done;
+
+        for (uint16_t i = 0; i < k; i++)
+            p[i] = src[done + i];
+
+        ring_publish(r, k);
+        done += k;
+    }
+
+    return done;
+}
+
+/* ---- Consumer side ---- */
+
+// Pop one byte (returns 0 if empty)
+static inline uint8_t ring_pop(RING_t *r, uint8_t *b)
+{
+    uint16_t tail = r->tail;
+
+    if (r->head == tail)
+        return 0;
+
+    RING_ACQUIRE();                 // head before data
+    *b = r->buf[tail & r->mask];
+    RING_RELEASE();                 // data read before the slot is freed
+    r->tail = tail + 1;
+    return 1;
+}
+
+// Contiguous readable bytes starting at the read position
+static inline uint16_t ring_peek(RING_t *r, uint8_t **p)
+{
+    uint16_t tail = r->tail;
+    uint16_t count = (uint16_t)(r->head - tail);
+    uint16_t to_end = (uint16_t)(r->mask + 1 - (tail & r->mask));
+
+    RING_ACQUIRE();
+    *p = &r->buf[tail & r->mask];
+    return count < to_end ? count : to_end;
+}
+
+// Release n peeked bytes back to the producer
+static inline void ring_commit(RING_t *r, uint16_t n)
+{
+    RING_RELEASE();
+    r->tail = r->tail + n;
+}
+
+// Pop up to n bytes (returns how many were read)
+static inline uint16_t ring_pop_bulk(RING_t *r, uint8_t *dst, uint16_t n)
+{
+    uint16_t done = 0;
+
+    while (done < n)
+    {
+        uint8_t *p;
+        uint16_t k = ring_peek(r, &p);
+
+        if (k == 0)
+            break;
+        if (k > n - done)
+            k = n - done;
+
+        for (uint16_t i = 0; i < k; i++)
+            dst[done + i] = p[i];
+
+        ring_commit(r, k);
+        done += k;
+    }
+
+    return done;
+}
+
+#endif
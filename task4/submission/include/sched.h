@@ -0,0 +1,40 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+/* Task table size and number of priority levels (0 = highest) */
+#define SCHED_MAX_TASKS     8
+#define SCHED_PRIOS         4
+
+/* Invalid task id */
+#define SCHED_NONE          0xFF
+
+typedef uint8_t SCHED_Task_t;
+
+// Task handler: runs to completion with the events posted since last run
+typedef void (*SCHED_Handler_t)(uint16_t events);
+
+// Per-task statistics
+typedef struct
+{
+    uint32_t runs;
+    uint32_t wcet_cycles;   // longest single run, HCLK cycles
+} SCHED_Stats_t;
+
+// Clear the task table and register the 'tasks' command
+void SCHED_Init(void);
+
+// Add a task (returns its id, SCHED_NONE if the table is full)
+SCHED_Task_t SCHED_TaskCreate(const char *name, SCHED_Handler_t fn, uint8_t prio);
+
+// Post events to a task (ISR-safe)
+void SCHED_Post(SCHED_Task_t t, uint16_t events);
+
+// Run ready tasks by priority, sleep (WFI) when idle; never returns
+void SCHED_Run(void) __attribute__((noreturn));
+
+// Statistics of a task
+const SCHED_Stats_t *SCHED_GetStats(SCHED_Task_t t);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+#include <stdint.h>
+#include "driver_rcc.h"
+#include "driver_pfic.h"
+
+/* Timer pool size (16 bytes each, at most 254) */
+#ifndef SWTIMER_MAX
+#define SWTIMER_MAX     16
+#endif
+
+/* Wheel geometry: 3 levels of 2^SWTIMER_BITS slots (1 ms / 32 ms / 1 s) */
+#define SWTIMER_BITS    5
+#define SWTIMER_SLOTS   (1 << SWTIMER_BITS)
+#define SWTIMER_LEVELS  3
+
+/* Invalid timer handle */
+#define SWTIMER_NONE    0xFF
+
+/* Create flags */
+#define SWTIMER_ISR     0x01    // run callback in SysTick interrupt context
+
+typedef uint8_t SWTimer_t;
+
+// Expiry callback; deferred ones run from SWTIMER_Poll()
+typedef void (*SWTIMER_Callback_t)(SWTimer_t t);
+
+// Clear the pool and hook the wheel into SysTick
+void SWTIMER_Init(void);
+
+// Allocate/free a timer from the static pool
+SWTimer_t SWTIMER_Create(SWTIMER_Callback_t cb, uint8_t flags);
+void SWTIMER_Delete(SWTimer_t t);
+
+// Arm (period_ms 0 = one-shot) / disarm a timer
+void SWTIMER_Start(SWTimer_t t, uint32_t delay_ms, uint32_t period_ms);
+void SWTIMER_Stop(SWTimer_t t);
+uint8_t SWTIMER_Active(SWTimer_t t);
+
+// Run deferred callbacks; call from the super-loop
+void SWTIMER_Poll(void);
+
+// Called from SysTick when a deferred callback has been queued
+void SWTIMER_SetNotify(void (*fn)(void));
+
+#endif
@@ -0,0 +1,19 @@
+#include "board.h"
+
+/*********************************************************************
+ * @var     board_pins
+ *
+ * @brief   Every application pin of the board in one table.
+ *
+ * @note    - Applied at startup with HAL_GPIO_InitTable(): one CFGLR
+ *            write per port and one clock-enable write in total.
+ *          - Pins owned by drivers are configured by the driver itself
+ *            and listed here for reference only:
+ *              PD5 USART1_TX, PD6 USART1_RX  (driver_uart_debug.c)
+ */
+const GPIO_PinConfig_t board_pins[] =
+{
+    { PIN(D, 4), GPIO_MODE_OUTPUT_50MHz, GPIO_CNF_PUSH_PULL, 0 },   // LED, off
+};
+
+const uint8_t board_pin_count = sizeof(board_pins) / sizeof(board_pins[0]);
@@ -0,0 +1,386 @@
+#include "capture.h"
+#include "cli.h"
+#include "jobs.h"
+#include "critical.h"
+
+#if (CAPTURE_BUF_SIZE & 1) != 0
+#error "CAPTURE_BUF_SIZE must be even"
+#endif
+
+#define CAPTURE_HALF    (CAPTURE_BUF_SIZE / 2)
+
+/*
+ * Logic-analyzer capture: TIM2 update events request DMA channel 2,
+ * which copies the low byte of GPIOx->INDR into cap_buf. Up to
+ * CAPTURE_BUF_SIZE samples are taken in one shot; longer captures run
+ * the DMA in circular mode and a background job run-length encodes one
+ * half while the hardware fills the other.
+ *
+ * A full half is first copied to cap_snap and only then encoded and
+ * printed. The copy is fast, and the job checks that the DMA did not
+ * start on that half again before it was done. Printing, which is slow,
+ * never reads samples the DMA may be overwriting.
+ */
+static uint8_t cap_buf[CAPTURE_BUF_SIZE];
+static uint8_t cap_snap[CAPTURE_HALF];
+
+/* Set by the DMA interrupt, cleared by the job (no shared bits) */
+static volatile uint8_t cap_full[2];    // buffer half holds new samples
+static volatile uint8_t cap_overrun;
+static volatile uint8_t cap_active;     // timer and DMA running
+static volatile uint32_t cap_filled;    // samples written by the DMA
+static uint8_t  cap_next;               // half the job takes next
+
+static uint8_t  cap_job;                // id of the encoding job
+static uint8_t  cap_mask;               // pins that exist on the port
+static uint8_t  cap_oneshot;
+static uint32_t cap_total;
+static uint32_t cap_left;               // samples not yet encoded
+
+/* Current run and output state */
+static uint8_t  run_val;
+static uint32_t run_len;
+static uint32_t run_count;
+static uint8_t  run_col;
+
+static void cap_dma_event(uint32_t flags);
+
+/* Stop the timer and the DMA channel */
+static void cap_stop(void)
+{
+    TIM2->CTLR1 &= ~TIM_CTLR1_CEN;
+    TIM2->DMAINTENR &= ~TIM_DMAINTENR_UDE;
+    DMA1_CH(DMA_CH_TIM2_UP)->CFGR &= ~DMA_CFGR_EN;
+    cap_active = 0;
+}
+
+/* Print one finished run: "a5" or "a5*120" */
+static void run_emit(void)
+{
+    if (run_len == 0)
+        return;
+
+    if (run_len == 1)
+        HAL_UART_Printf("%02x ", run_val);
+    else
+        HAL_UART_Printf("%02x*%lu ", run_val, (unsigned long)run_len);
+
+    run_count++;
+    if (++run_col == CAPTURE_RUNS_PER_LINE)
+    {
+        HAL_UART_SendString("\r\n");
+        run_col = 0;
+    }
+}
+
+/* Job kill hook (kill command, Ctrl-C): release TIM2 and the DMA */
+static void capture_kill(JOB_t *job)
+{
+    cap_stop();
+}
+
+/* Run-length encode n samples */
+static void run_encode(const uint8_t *s, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint8_t v = s[i] & cap_mask;
+
+        if (v == run_val && run_len)
+        {
+            run_len++;
+            continue;
+        }
+
+        run_emit();
+        run_val = v;
+        run_len = 1;
+    }
+}
+
+/* Encode the rest of a half (or of the one-shot buffer) */
+static void cap_consume(const uint8_t *s, uint32_t n)
+{
+    if (n > cap_left)
+        n = cap_left;
+
+    run_encode(s, n);
+    cap_left -= n;
+}
+
+/* Background step: encode full halves, print the summary at the end */
+static uint8_t capture_step(JOB_t *job)
+{
+    if (cap_oneshot)
+    {
+        if (cap_active)
+            return 1;
+
+        cap_consume(cap_buf, cap_left);
+    }
+    else
+    {
+        while (cap_full[cap_next] && !cap_overrun)
+        {
+            uint8_t h = cap_next;
+            const uint8_t *src = cap_buf + (h ? CAPTURE_HALF : 0);
+
+            for (uint16_t i = 0; i < CAPTURE_HALF; i++)
+                cap_snap[i] = src[i];
+
+            /*
+             * The ISR flags an overrun as soon as the DMA re-enters a
+             * half that is still marked full. Checking and releasing
+             * together means the copy is known to be intact, so the
+             * check comes before anything is printed.
+             */
+            uint32_t irq = CRIT_ENTER();
+            uint8_t ok = !cap_overrun;
+            if (ok)
+                cap_full[h] = 0;
+            CRIT_EXIT(irq);
+
+            if (!ok)
+                break;
+
+            cap_next = !h;
+            cap_consume(cap_snap, CAPTURE_HALF);
+        }
+
+        if (cap_left && !cap_overrun)
+            return 1;
+
+        cap_stop();
+    }
+
+    run_emit();
+
+    if (run_col)
+        HAL_UART_SendString("\r\n");
+
+    if (cap_overrun)
+        HAL_UART_Printf("Capture overrun (%lu samples lost), lower the rate\r\n",
+                        (unsigned long)cap_left);
+    else
+        HAL_UART_Printf("Capture done, %lu runs\r\n", (unsigned long)run_count);
+
+    return 0;
+}
+
+/*********************************************************************
+ * @fn      DMA1_Channel2_IRQHandler
+ *
+ * @brief   Marks a buffer half as full (streaming) or ends a one-shot
+ *          capture.
+ *
+ * @return  none
+ *
+ * @note    - HT = first half full, TC = second half full.
+ *          - When one half completes, the DMA continues into the other.
+ *            If the job has not yet copied that other half, the capture
+ *            stops at once and is flagged as an overrun. The unread
+ *            samples are then never printed.
+ *          - Stops the hardware once enough samples have been taken.
+ */
+void DMA1_Channel2_IRQHandler(void)
+{
+    IRQ_ENTER();
+
+    uint32_t flags = DMA1->INTFR;
+
+    DMA1->INTFCR = DMA_GIF(DMA_CH_TIM2_UP) | DMA_HTIF(DMA_CH_TIM2_UP) |
+                   DMA_TCIF(DMA_CH_TIM2_UP) | DMA_TEIF(DMA_CH_TIM2_UP);
+
+    cap_dma_event(flags);
+
+    IRQ_EXIT(IRQ_DMA1_CH2);
+}
+
+/* DMA half/complete event of the running capture */
+static void cap_dma_event(uint32_t flags)
+{
+    if (cap_oneshot)
+    {
+        if (flags & DMA_TCIF(DMA_CH_TIM2_UP))
+            cap_stop();
+        return;
+    }
+
+    for (uint8_t h = 0; h < 2; h++)
+    {
+        if (!(flags & (h ? DMA_TCIF(DMA_CH_TIM2_UP) : DMA_HTIF(DMA_CH_TIM2_UP))))
+            continue;
+
+        /* The DMA now writes the other half: it must have been copied */
+        if (cap_full[h] || cap_full[!h])
+        {
+            cap_overrun = 1;
+            cap_stop();
+            return;
+        }
+
+        cap_full[h] = 1;
+        cap_filled += CAPTURE_HALF;
+    }
+
+    if (cap_filled >= cap_total)
+        cap_stop();
+}
+
+/*********************************************************************
+ * @fn      CAPTURE_Start
+ *
+ * @brief   Starts sampling a GPIO port and streaming the result.
+ *
+ * @param   port    - GPIOA, GPIOC or GPIOD
+ * @param   rate_hz - Sample rate (1 to CAPTURE_MAX_RATE)
+ * @param   samples - Number of samples to take
+ *
+ * @return  uint8_t - 1 if started, 0 if a capture is running or no job
+ *                    slot is free
+ *
+ * @note    - Output is one "vv*count" run per value change (hex pin
+ *            levels, count omitted when 1), CAPTURE_RUNS_PER_LINE
+ *            runs per line.
+ *          - Up to CAPTURE_BUF_SIZE samples are taken in one shot at
+ *            full rate; longer captures are limited by how fast the
+ *            runs can be printed and stop with an overrun message
+ *            when the UART cannot keep up.
+ *          - Uses TIM2 (HAL_TIM_SetUpdateRate) and DMA1 channel 2.
+ */
+uint8_t CAPTURE_Start(GPIO_RegDef_t *port, uint32_t rate_hz, uint32_t samples)
+{
+    DMA_Channel_RegDef_t *ch = DMA1_CH(DMA_CH_TIM2_UP);
+
+    if (CAPTURE_Busy() || rate_hz == 0 || samples == 0)
+        return 0;
+
+    /* Idle hardware; a killed capture was stopped by its hook */
+    cap_stop();
+
+    cap_job = JOB_Start("capture", capture_step, 0, 0, 0);
+    if (!cap_job)
+        return 0;
+
+    JOB_SetKillHook(cap_job, capture_kill);
+
+    if (port == GPIOA)
+        cap_mask = GPIO_VALID_PINS_A;
+    else if (port == GPIOC)
+        cap_mask = GPIO_VALID_PINS_C;
+    else
+        cap_mask = GPIO_VALID_PINS_D;
+
+    cap_oneshot = samples <= CAPTURE_BUF_SIZE;
+    cap_total = samples;
+    cap_left = samples;
+    cap_filled = 0;
+    cap_full[0] = cap_full[1] = 0;
+    cap_next = 0;
+    cap_overrun = 0;
+    run_len = 0;
+    run_count = 0;
+    run_col = 0;
+
+    RCC->AHBPCENR |= RCC_DMA1EN;
+    RCC->APB1PCENR |= RCC_TIM2EN;
+
+    /* Timer base; UG loads PSC before the DMA request is enabled */
+    TIM2->CTLR1 = 0;
+    HAL_TIM_SetUpdateRate(TIM2, rate_hz);
+
+    /* INDR (32-bit read) → low byte into the buffer */
+    ch->CFGR  = 0;
+    ch->PADDR = (uint32_t)(uintptr_t)&port->INDR;
+    ch->MADDR = (uint32_t)(uintptr_t)cap_buf;
+    ch->CNTR  = cap_oneshot ? samples : CAPTURE_BUF_SIZE;
+    DMA1->INTFCR = DMA_GIF(DMA_CH_TIM2_UP) | DMA_HTIF(DMA_CH_TIM2_UP) |
+                   DMA_TCIF(DMA_CH_TIM2_UP) | DMA_TEIF(DMA_CH_TIM2_UP);
+
+    ch->CFGR = DMA_CFGR_MINC | DMA_CFGR_PSIZE_32 | DMA_CFGR_MSIZE_8 |
+               DMA_CFGR_PL_HIGH | DMA_CFGR_TCIE |
+               (cap_oneshot ? 0 : (DMA_CFGR_CIRC | DMA_CFGR_HTIE));
+    ch->CFGR |= DMA_CFGR_EN;
+
+    HAL_PFIC_EnableIRQ(IRQ_DMA1_CH2);
+
+    cap_active = 1;
+    TIM2->DMAINTENR = TIM_DMAINTENR_UDE;
+    TIM2->CTLR1 = TIM_CTLR1_CEN;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      CAPTURE_Busy
+ *
+ * @brief   Checks whether a capture is still sampling or printing.
+ *
+ * @return  uint8_t - 1 while the capture job runs
+ */
+uint8_t CAPTURE_Busy(void)
+{
+    return JOB_Running(cap_job);
+}
+
+
+/* Port letter ("a", "c", "d") → GPIO registers, NULL if invalid */
+static GPIO_RegDef_t *cap_port(const char *s)
+{
+    if (s[0] == '\0' || s[1] != '\0')
+        return NULL;
+
+    switch (s[0])
+    {
+    case 'a': return GPIOA;
+    case 'c': return GPIOC;
+    case 'd': return GPIOD;
+    default:  return NULL;
+    }
+}
+
+/* ---- CAPTURE ---- */
+static void cmd_capture(uint8_t argc, char *argv[])
+{
+    GPIO_RegDef_t *port = cap_port(argv[1]);
+    int32_t rate, samples;
+
+    if (port == NULL)
+    {
+        HAL_UART_SendString("Error: port must be a, c or d\r\n");
+        return;
+    }
+
+    if (!CLI_ArgInt("rate", argv[2], 1, CAPTURE_MAX_RATE, &rate) ||
+        !CLI_ArgInt("samples", argv[3], 1, INT32_MAX, &samples))
+        return;
+
+    if (!CAPTURE_Start(port, rate, samples))
+    {
+        HAL_UART_SendString("Error: capture busy\r\n");
+        return;
+    }
+
+    HAL_UART_Printf("Capturing P%c, %ld Hz, %ld samples\r\n",
+                    argv[1][0] - 'a' + 'A', (long)rate, (long)samples);
+}
+
+static const CLI_Command_t capture_cmds[] =
+{
+    { "capture", "<port> <rate> <samples>", 3, 3, cmd_capture,
+      "Sample a GPIO port and print it run-length encoded" },
+};
+
+/*********************************************************************
+ * @fn      CAPTURE_Init
+ *
+ * @brief   Registers the 'capture' command.
+ *
+ * @return  none
+ *
+ * @note    Call after CLI_Init() and JOB_Init().
+ */
+void CAPTURE_Init(void)
+{
+    CLI_Register(capture_cmds, sizeof(capture_cmds) / sizeof(capture_cmds[0]));
+}
@@ -1,4 +1,32 @@
 #include "cli.h"
+#include "jobs.h"
+
+#if (CLI_HASH_SIZE & (CLI_HASH_SIZE - 1)) != 0
+#error "CLI_HASH_SIZE must be a power of two"
+#endif
+
+/*
+ * Registered command tables. The tables themselves are const (flash);
+ * RAM only holds the table pointers and a hash index of command
+ * numbers, so lookup costs one hash and (normally) one compare no
+ * matter how many commands exist.
+ */
+static const CLI_Command_t *cli_tables[CLI_MAX_TABLES];
+static uint8_t cli_table_len[CLI_MAX_TABLES];
+static uint8_t cli_num_tables;
+static uint8_t cli_num_cmds;
+
+/* Hash slot → command number + 1 (0 = empty slot) */
+static uint8_t cli_hash[CLI_HASH_SIZE];
+
+/*
+ * Line reader that holds the terminal (see CLI_TakeLine). The console
+ * stays the only consumer of the RX buffer and line editor; while buf
+ * is set, the next completed line is copied here instead of being run.
+ */
+static char   *cli_reader_buf;
+static uint8_t cli_reader_len;
+static uint8_t cli_reader_res;     // UART_LINE_NONE until delivered
 
 
 /*********************************************************************
@@ -11,7 +39,7 @@
  * @return  none
  *
  * @note    - Modifies the original string.
- *          - Uses standard C tolower().
+ *          - ASCII only (no locale tables from tolower()).
  *          - Stops at null terminator '\0'.
  *          - Declared static since it is used only within cli.c.
  */
@@ -20,11 +48,259 @@ static void str_to_lower(char *s)
 {
     while (*s)
     {
-        *s = tolower((unsigned char)*s);
+        if (*s >= 'A' && *s <= 'Z')
+            *s += 'a' - 'A';
         s++;
     }
 }
 
+/* String equality (replaces strcmp() so libc string code is not linked) */
+static uint8_t str_eq(const char *a, const char *b)
+{
+    while (*a && *a == *b)
+    {
+        a++;
+        b++;
+    }
+
+    return *a == *b;
+}
+
+/* djb2-style string hash (shift/add only, no multiply) */
+static uint8_t cli_hash_str(const char *s)
+{
+    uint32_t h = 5381;
+
+    while (*s)
+        h = ((h << 5) + h) ^ (uint8_t)*s++;
+
+    return h & (CLI_HASH_SIZE - 1);
+}
+
+/* Command number → table entry */
+static const CLI_Command_t *cli_cmd_at(uint8_t n)
+{
+    for (uint8_t t = 0; t < cli_num_tables; t++)
+    {
+        if (n < cli_table_len[t])
+            return &cli_tables[t][n];
+        n -= cli_table_len[t];
+    }
+
+    return NULL;
+}
+
+/* Hash lookup with linear probing */
+static const CLI_Command_t *cli_find(const char *name)
+{
+    uint8_t h = cli_hash_str(name);
+
+    for (uint8_t probe = 0; probe < CLI_HASH_SIZE; probe++)
+    {
+        uint8_t slot = cli_hash[h];
+
+        if (slot == 0)
+            return NULL;
+
+        const CLI_Command_t *c = cli_cmd_at(slot - 1);
+        if (str_eq(c->name, name))
+            return c;
+
+        h = (h + 1) & (CLI_HASH_SIZE - 1);
+    }
+
+    return NULL;
+}
+
+/*
+ * Split a line into words in place, returns argc. Separators (space,
+ * tab) are overwritten with '\0' so argv[] points into the line itself.
+ */
+static uint8_t cli_split(char *s, char *argv[])
+{
+    uint8_t argc = 0;
+
+    while (*s)
+    {
+        while (*s == ' ' || *s == '\t')
+            *s++ = '\0';
+
+        if (*s == '\0' || argc == CLI_MAX_ARGS)
+            break;
+
+        argv[argc++] = s;
+
+        while (*s && *s != ' ' && *s != '\t')
+            s++;
+    }
+
+    return argc;
+}
+
+
+/* ---- HELP ---- */
+static void cmd_help(uint8_t argc, char *argv[])
+{
+    HAL_UART_SendString("Commands:\r\n");
+
+    for (uint8_t n = 0; n < cli_num_cmds; n++)
+    {
+        const CLI_Command_t *c = cli_cmd_at(n);
+
+        HAL_UART_SendString(c->name);
+        if (c->args[0])
+            HAL_UART_Printf(" %s", c->args);
+        HAL_UART_Printf(" - %s\r\n", c->help);
+    }
+}
+
+/* ---- LED ON / OFF ---- */
+static void cmd_led(uint8_t argc, char *argv[])
+{
+    if (str_eq(argv[1], "on"))
+    {
+        pin_set(LED);
+        HAL_UART_SendString("LED ON\r\n");
+    }
+    else if (str_eq(argv[1], "off"))
+    {
+        pin_clr(LED);
+        HAL_UART_SendString("LED OFF\r\n");
+    }
+    else
+    {
+        HAL_UART_SendString("Usage: led <on|off>\r\n");
+    }
+}
+
+/* Background blink, written as a protothread: data[0] = ms, data[1] = count */
+static PT_THREAD(blink_pt(JOB_t *job))
+{
+    PT_BEGIN(&job->pt);
+
+    while (job->data[1] > 0)
+    {
+        PT_DELAY_MS(&job->pt, job->data[0]);
+        pin_toggle(LED);
+        job->data[1]--;
+    }
+
+    PT_END(&job->pt);
+}
+
+/* ---- BLINK ---- */
+static void cmd_blink(uint8_t argc, char *argv[])
+{
+    int32_t ms, count;
+
+    if (!CLI_ArgInt("ms", argv[1], 1, INT32_MAX, &ms) ||
+        !CLI_ArgInt("count", argv[2], 1, INT32_MAX, &count))
+        return;
+
+    uint8_t id = JOB_Start("blink", blink_pt, 0, ms, count);
+
+    if (!id)
+    {
+        HAL_UART_SendString("Error: too many jobs\r\n");
+        return;
+    }
+
+    HAL_UART_Printf("Blinking in background [%u]\r\n", id);
+}
+
+/* ---- READ PIN ---- */
+static void cmd_read(uint8_t argc, char *argv[])
+{
+    int32_t pin;
+
+    if (!CLI_ArgInt("pin", argv[1], 0, 15, &pin))
+        return;
+
+    uint8_t val = HAL_GPIO_ReadPin(GPIOD, pin);
+
+    HAL_UART_Printf("Pin value: %u\r\n", val);
+}
+
+/* ---- IRQ LATENCY ---- */
+static void cmd_irqlat(uint8_t argc, char *argv[])
+{
+    uint32_t table = HAL_PFIC_MeasureLatency(0);
+    uint32_t vtf = HAL_PFIC_MeasureLatency(1);
+
+    HAL_UART_Printf("IRQ entry: %lu cycles (vector table), %lu cycles (VTF)\r\n",
+                    (unsigned long)table, (unsigned long)vtf);
+}
+
+/* Built-in commands */
+static const CLI_Command_t cli_core_cmds[] =
+{
+    { "help",  "",             0, 0, cmd_help,  "Show available commands" },
+    { "led",   "<on|off>",     1, 1, cmd_led,   "Turn the LED on or off" },
+    { "blink", "<ms> <count>", 2, 2, cmd_blink, "Toggle the LED <count> times" },
+    { "read",  "<pin>",        1, 1, cmd_read,  "Read a GPIOD pin (0-15)" },
+    { "irqlat", "",            0, 0, cmd_irqlat, "Measure interrupt entry latency" },
+};
+
+
+/*********************************************************************
+ * @fn      CLI_Init
+ *
+ * @brief   Registers the built-in commands (help, led, blink, read,
+ *          irqlat).
+ *
+ * @return  none
+ *
+ * @note    Call once before CLI_Process(). Other modules add their
+ *          commands with CLI_Register().
+ */
+void CLI_Init(void)
+{
+    CLI_Register(cli_core_cmds, sizeof(cli_core_cmds) / sizeof(cli_core_cmds[0]));
+}
+
+/*********************************************************************
+ * @fn      CLI_Register
+ *
+ * @brief   Adds a const command table to the CLI.
+ *
+ * @param   table - Array of commands (kept by reference, must be static)
+ * @param   count - Number of entries in the table
+ *
+ * @return  uint8_t - 1 on success, 0 if the CLI is full or a command
+ *                    name is already taken (nothing is registered then)
+ *
+ * @note    - Names must be lower case (input is lower-cased).
+ *          - The hash index is kept at most 3/4 full so probes stay short.
+ *          - help lists commands in registration order.
+ */
+uint8_t CLI_Register(const CLI_Command_t *table, uint8_t count)
+{
+    if (cli_num_tables == CLI_MAX_TABLES)
+        return 0;
+
+    if (cli_num_cmds + count > (CLI_HASH_SIZE * 3) / 4)
+        return 0;
+
+    for (uint8_t i = 0; i < count; i++)
+        if (cli_find(table[i].name))
+            return 0;
+
+    cli_tables[cli_num_tables] = table;
+    cli_table_len[cli_num_tables] = count;
+    cli_num_tables++;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        uint8_t h = cli_hash_str(table[i].name);
+
+        while (cli_hash[h])
+            h = (h + 1) & (CLI_HASH_SIZE - 1);
+
+        cli_hash[h] = ++cli_num_cmds;
+    }
+
+    return 1;
+}
 
 /*********************************************************************
  * @fn      CLI_Process
@@ -36,97 +312,235 @@ static void str_to_lower(char *s)
  * @return  none
  *
  * @note    - Converts command to lowercase for case-insensitive matching.
- *          - Supports the following commands:
- *              help                → Shows available commands
- *              led on              → Turns LED ON
- *              led off             → Turns LED OFF
- *              blink <ms> <count>  → Blinks LED with delay and count
- *              read <pin>          → Reads GPIO pin value
- *          - Performs basic input validation.
- *          - Sends responses via UART.
- *          - Blocking behavior may occur during blink delays.
+ *          - Splits the line into words in place and looks the first
+ *            word up in the registered command tables.
+ *          - Checks the argument count against the table entry and
+ *            prints its usage line on mismatch.
+ *          - Empty lines are ignored.
+ *          - While a protothread waits in CLI_TakeLine() the line is
+ *            handed to it unchanged and no command runs.
+ *          - Long-running commands (blink) start background jobs and
+ *            return at once.
  */
 void CLI_Process(char *cmd)
 {
+    char *argv[CLI_MAX_ARGS];
+    uint8_t argc;
+
+    /* a protothread holds the terminal: the line is its input */
+    if (cli_reader_buf != NULL && cli_reader_res == UART_LINE_NONE)
+    {
+        uint8_t i;
+
+        for (i = 0; i + 1 < cli_reader_len && cmd[i] != '\0'; i++)
+            cli_reader_buf[i] = cmd[i];
+        cli_reader_buf[i] = '\0';
+        cli_reader_res = UART_LINE_READY;
+        return;
+    }
+
     /* normalize */
     str_to_lower(cmd);
 
-    /* ---- HELP ---- */
-    if (strcmp(cmd, "help") == 0)
+    argc = cli_split(cmd, argv);
+    if (argc == 0)
+        return;
+
+    const CLI_Command_t *c = cli_find(argv[0]);
+
+    /* ---- UNKNOWN ---- */
+    if (c == NULL)
     {
-        HAL_UART_SendString("Commands:\r\n");
-        HAL_UART_SendString("help\r\n");
-        HAL_UART_SendString("led on\r\n");
-        HAL_UART_SendString("led off\r\n");
-        HAL_UART_SendString("blink <ms> <count>\r\n");
-        HAL_UART_SendString("read <pin>\r\n");
+        HAL_UART_SendString("Error: Unknown command\r\n");
+        return;
     }
 
-    /* ---- LED ON ---- */
-    else if (strcmp(cmd, "led on") == 0)
+    if (argc - 1 < c->min_args || argc - 1 > c->max_args)
     {
-        HAL_GPIO_WritePin(LED_PORT, LED_PIN, 1);
-        HAL_UART_SendString("LED ON\r\n");
+        HAL_UART_Printf("Usage: %s %s\r\n", c->name, c->args);
+        return;
     }
 
-    /* ---- LED OFF ---- */
-    else if (strcmp(cmd, "led off") == 0)
+    c->handler(argc, argv);
+}
+
+/*********************************************************************
+ * @fn      CLI_TakeLine
+ *
+ * @brief   Non-blocking line input for protothreads, through the console.
+ *
+ * @param   buf    - Buffer for the line (also identifies the reader)
+ * @param   maxLen - Size of buf, terminator included
+ *
+ * @return  UART_LINE_NONE while waiting, then UART_LINE_READY or
+ *          UART_LINE_BREAK once
+ *
+ * @note    - The first call claims the terminal; the console then
+ *            passes its next line to buf (see CLI_Process) instead of
+ *            running it. The call that returns the result releases it.
+ *          - Only one reader at a time: other buffers get
+ *            UART_LINE_NONE until the holder has its line.
+ *          - Ctrl-C completes the read with UART_LINE_BREAK
+ *            (CLI_Break). A result its reader never collected (job
+ *            killed) is dropped by the next reader's claim.
+ *          - Call it from the main loop only (console context), not
+ *            from an interrupt.
+ */
+uint8_t CLI_TakeLine(char *buf, uint8_t maxLen)
+{
+    uint8_t res;
+
+    if (cli_reader_buf != buf)
     {
-        HAL_GPIO_WritePin(LED_PORT, LED_PIN, 0);
-        HAL_UART_SendString("LED OFF\r\n");
+        if (cli_reader_buf != NULL && cli_reader_res == UART_LINE_NONE)
+            return UART_LINE_NONE;          // terminal held by another reader
+
+        cli_reader_buf = buf;
+        cli_reader_len = maxLen;
+        cli_reader_res = UART_LINE_NONE;
+        return UART_LINE_NONE;
     }
 
-    /* ---- BLINK ---- */
-    else if (strncmp(cmd, "blink ", 6) == 0)
-    {
-        int ms = 0;
-        int count = 0;
+    res = cli_reader_res;
+    if (res != UART_LINE_NONE)
+        cli_reader_buf = NULL;
 
-        /* Parse two integers */
-        if (sscanf(&cmd[6], "%d %d", &ms, &count) != 2)
-        {
-            HAL_UART_SendString("Usage: blink <ms> <count>\r\n");
-            return;
-        }
+    return res;
+}
 
-        if (ms <= 0 || count <= 0)
-        {
-            HAL_UART_SendString("Error: invalid values\r\n");
-            return;
-        }
+/*********************************************************************
+ * @fn      CLI_Break
+ *
+ * @brief   Passes a Ctrl-C from the console to a waiting CLI_TakeLine().
+ *
+ * @return  none
+ */
+void CLI_Break(void)
+{
+    if (cli_reader_buf != NULL && cli_reader_res == UART_LINE_NONE)
+    {
+        cli_reader_buf[0] = '\0';
+        cli_reader_res = UART_LINE_BREAK;
+    }
+}
 
-        HAL_UART_SendString("Blinking...\r\n");
+/*********************************************************************
+ * @fn      CLI_ParseInt
+ *
+ * @brief   Parses a whole string as a signed integer with range check.
+ *
+ * @param   s   - String to parse ("42", "-7", "0x1F", "0b1010")
+ * @param   min - Smallest accepted value
+ * @param   max - Largest accepted value
+ * @param   out - Parsed value (written only on CLI_PARSE_OK)
+ *
+ * @return  CLI_ParseResult_t - CLI_PARSE_OK, or why parsing failed
+ *
+ * @note    - Replaces atoi()/sscanf(): rejects trailing garbage
+ *            ("12x"), empty input and values that overflow 32 bits.
+ *          - Optional leading '-'; prefixes 0x/0X and 0b/0B.
+ *          - Uses shifts and adds only (no multiply/divide on RV32EC).
+ */
+CLI_ParseResult_t CLI_ParseInt(const char *s, int32_t min, int32_t max, int32_t *out)
+{
+    uint8_t neg = 0;
+    uint8_t shift = 0;      // 0 = decimal, 4 = hex, 1 = binary
+    uint32_t v = 0;
 
-        for (int i = 0; i < count; i++)
-        {
-            HAL_GPIO_TogglePin(LED_PORT, LED_PIN);
-            HAL_Delay_ms(ms);
-        }
+    if (*s == '-')
+    {
+        neg = 1;
+        s++;
+    }
 
-        HAL_UART_SendString("Done\r\n");
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+    {
+        shift = 4;
+        s += 2;
+    }
+    else if (s[0] == '0' && (s[1] == 'b' || s[1] == 'B'))
+    {
+        shift = 1;
+        s += 2;
     }
 
-    /* ---- READ PIN ---- */
-    else if (strncmp(cmd, "read ", 5) == 0)
+    if (*s == '\0')
+        return CLI_PARSE_EMPTY;
+
+    for (; *s; s++)
     {
-        int pin = atoi(&cmd[5]);
+        char c = *s;
+        uint8_t d;
+
+        if (c >= '0' && c <= '9')
+            d = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            d = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            d = c - 'A' + 10;
+        else
+            return CLI_PARSE_SYNTAX;
 
-        if (pin < 0 || pin > 15)
+        if (shift == 0)
         {
-            HAL_UART_SendString("Error: invalid pin\r\n");
-            return;
+            if (d > 9)
+                return CLI_PARSE_SYNTAX;
+
+            /* v * 10 + d must stay within 32 bits */
+            if (v > 429496729U || (v == 429496729U && d > 5))
+                return CLI_PARSE_RANGE;
+
+            v = (v << 3) + (v << 1) + d;
         }
+        else
+        {
+            if (d >= (1U << shift))
+                return CLI_PARSE_SYNTAX;
 
-        uint8_t val = HAL_GPIO_ReadPin(GPIOD, pin);
+            if (v >> (32 - shift))
+                return CLI_PARSE_RANGE;
 
-        HAL_UART_SendString("Pin value: ");
-        HAL_UART_Print("", val, 10);
-        HAL_UART_SendString("\r\n");
+            v = (v << shift) | d;
+        }
     }
 
-    /* ---- UNKNOWN ---- */
+    /* Signed range: magnitude up to 2^31 for negatives, 2^31-1 otherwise */
+    if (v > (neg ? 0x80000000U : 0x7FFFFFFFU))
+        return CLI_PARSE_RANGE;
+
+    int32_t val = neg ? (int32_t)(0U - v) : (int32_t)v;
+
+    if (val < min || val > max)
+        return CLI_PARSE_RANGE;
+
+    *out = val;
+    return CLI_PARSE_OK;
+}
+
+/*********************************************************************
+ * @fn      CLI_ArgInt
+ *
+ * @brief   Parses a command argument and reports errors on the UART.
+ *
+ * @param   name - Argument name used in the error message
+ * @param   s    - Argument string
+ * @param   min  - Smallest accepted value
+ * @param   max  - Largest accepted value
+ * @param   out  - Parsed value
+ *
+ * @return  uint8_t - 1 if valid, 0 if an error was printed
+ */
+uint8_t CLI_ArgInt(const char *name, const char *s, int32_t min, int32_t max, int32_t *out)
+{
+    CLI_ParseResult_t r = CLI_ParseInt(s, min, max, out);
+
+    if (r == CLI_PARSE_OK)
+        return 1;
+
+    if (r == CLI_PARSE_RANGE)
+        HAL_UART_Printf("Error: %s must be %ld..%ld\r\n", name, (long)min, (long)max);
     else
-    {
-        HAL_UART_SendString("Error: Unknown command\r\n");
-    }
+        HAL_UART_Printf("Error: %s is not a number\r\n", name);
+
+    return 0;
 }
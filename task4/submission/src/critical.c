@@ -0,0 +1,237 @@
+#include "critical.h"
+
+#if defined(IRQ_STATS)
+
+#include "driver_rcc.h"
+#include "cli.h"
+
+/* Per-handler run time in cycles */
+typedef struct
+{
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;           // for the average; restarts when it would wrap
+    uint32_t count;
+    uint8_t  irq;
+} IRQSTAT_Entry_t;
+
+static IRQSTAT_Entry_t irqstat_tab[IRQSTAT_MAX];
+static uint8_t irqstat_used;
+
+/* Longest masked span and where it started */
+static uint32_t crit_t0;
+static uint8_t  crit_wrap0;
+static const char *crit_file;
+static uint16_t crit_line;
+static uint32_t crit_max;
+static const char *crit_max_file;
+static uint16_t crit_max_line;
+
+/* Cycles from t0 to now (less than one SysTick period) */
+static uint32_t cycles_since(uint32_t t0)
+{
+    uint32_t now = SysTick->CNT;
+
+    return (now >= t0) ? now - t0 : now + SysTick->CMP + 1 - t0;
+}
+
+/*********************************************************************
+ * @fn      crit_enter_stat
+ *
+ * @brief   CRIT_ENTER() with IRQ_STATS: masks interrupts and starts
+ *          timing if this is the outermost section.
+ *
+ * @param   file, line - Call site (from the macro)
+ *
+ * @return  uint32_t - Previous mstatus, for CRIT_EXIT()
+ */
+uint32_t crit_enter_stat(const char *file, uint16_t line)
+{
+    uint32_t s = crit_enter();
+
+    if (s & MSTATUS_MIE)
+    {
+        crit_file = file;
+        crit_line = line;
+        crit_wrap0 = SysTick->SR & SYSTICK_CNTIF;
+        crit_t0 = SysTick->CNT;
+    }
+
+    return s;
+}
+
+/*********************************************************************
+ * @fn      crit_exit_stat
+ *
+ * @brief   CRIT_EXIT() with IRQ_STATS: ends timing of an outermost
+ *          section and unmasks interrupts.
+ *
+ * @param   mstatus - Value returned by CRIT_ENTER()
+ *
+ * @return  none
+ *
+ * @note    - Spans up to two SysTick periods (2 ms) are exact: the tick
+ *            cannot be serviced while masked, so a reload shows up as
+ *            a CNTIF flag that was not set on entry.
+ *          - Nested sections only restore the mask; the outermost one
+ *            is measured.
+ */
+void crit_exit_stat(uint32_t mstatus)
+{
+    if (mstatus & MSTATUS_MIE)
+    {
+        uint32_t now = SysTick->CNT;
+        uint32_t period = SysTick->CMP + 1;
+        uint8_t reloaded = !crit_wrap0 && (SysTick->SR & SYSTICK_CNTIF);
+        uint32_t span = (now >= crit_t0) ? now - crit_t0 : now + period - crit_t0;
+
+        /* Counter reloaded and already passed the start value again */
+        if (reloaded && now >= crit_t0)
+            span += period;
+
+        if (span > crit_max)
+        {
+            crit_max = span;
+            crit_max_file = crit_file;
+            crit_max_line = crit_line;
+        }
+    }
+
+    crit_exit(mstatus);
+}
+
+/*********************************************************************
+ * @fn      irqstat_now
+ *
+ * @brief   IRQ_ENTER() timestamp.
+ *
+ * @return  uint32_t - SysTick->CNT
+ */
+uint32_t irqstat_now(void)
+{
+    return SysTick->CNT;
+}
+
+/*********************************************************************
+ * @fn      irqstat_exit
+ *
+ * @brief   IRQ_EXIT(): adds one handler run to its statistics.
+ *
+ * @param   irq - Interrupt number of the handler
+ * @param   t0  - IRQ_ENTER() timestamp
+ *
+ * @return  none
+ *
+ * @note    The first IRQSTAT_MAX different handlers get a slot; later
+ *          ones are not tracked.
+ */
+void irqstat_exit(IRQn_t irq, uint32_t t0)
+{
+    uint32_t c = cycles_since(t0);
+    IRQSTAT_Entry_t *e = NULL;
+
+    for (uint8_t i = 0; i < irqstat_used; i++)
+    {
+        if (irqstat_tab[i].irq == irq)
+        {
+            e = &irqstat_tab[i];
+            break;
+        }
+    }
+
+    if (e == NULL)
+    {
+        uint32_t s = crit_enter();
+
+        if (irqstat_used < IRQSTAT_MAX)
+        {
+            e = &irqstat_tab[irqstat_used];
+            e->irq = irq;
+            e->min = UINT32_MAX;
+            e->max = 0;
+            e->sum = 0;
+            e->count = 0;
+            irqstat_used++;
+        }
+
+        crit_exit(s);
+
+        if (e == NULL)
+            return;
+    }
+
+    if (c < e->min)
+        e->min = c;
+    if (c > e->max)
+        e->max = c;
+
+    if (e->sum + c < e->sum)
+    {
+        e->sum = 0;
+        e->count = 0;
+    }
+
+    e->sum += c;
+    e->count++;
+}
+
+
+/* ---- IRQSTAT ---- */
+static void cmd_irqstat(uint8_t argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        uint32_t s = crit_enter();
+        irqstat_used = 0;
+        crit_max = 0;
+        crit_max_file = NULL;
+        crit_exit(s);
+
+        HAL_UART_SendString("irqstat cleared\r\n");
+        return;
+    }
+
+    HAL_UART_SendString("irq   count     min     avg     max (cycles)\r\n");
+
+    for (uint8_t i = 0; i < irqstat_used; i++)
+    {
+        IRQSTAT_Entry_t e;
+        uint32_t s = crit_enter();
+        e = irqstat_tab[i];
+        crit_exit(s);
+
+        HAL_UART_Printf("%3u %7lu %7lu %7lu %7lu\r\n", e.irq,
+                        (unsigned long)e.count, (unsigned long)e.min,
+                        (unsigned long)(e.count ? e.sum / e.count : 0),
+                        (unsigned long)e.max);
+    }
+
+    if (crit_max_file)
+        HAL_UART_Printf("Longest masked: %lu cycles at %s:%u\r\n",
+                        (unsigned long)crit_max, crit_max_file, crit_max_line);
+    else
+        HAL_UART_SendString("Longest masked: none\r\n");
+}
+
+static const CLI_Command_t irqstat_cmds[] =
+{
+    { "irqstat", "[clear]", 0, 1, cmd_irqstat, "Interrupt timing and longest masked span" },
+};
+
+#endif
+
+/*********************************************************************
+ * @fn      IRQSTAT_Init
+ *
+ * @brief   Registers the 'irqstat' command.
+ *
+ * @return  none
+ *
+ * @note    Empty unless built with IRQ_STATS.
+ */
+void IRQSTAT_Init(void)
+{
+#if defined(IRQ_STATS)
+    CLI_Register(irqstat_cmds, sizeof(irqstat_cmds) / sizeof(irqstat_cmds[0]));
+#endif
+}
@@ -0,0 +1,249 @@
+#include "driver_exti.h"
+#include "critical.h"
+
+/* Per-line state */
+typedef struct
+{
+    GPIO_Pin_t       pin;
+    EXTI_Callback_t  cb;
+    uint16_t         debounce_ms;
+    volatile uint16_t countdown;    // debounce time left, 0 = idle
+    uint8_t          edge;
+    uint8_t          level;         // last accepted (stable) level
+    volatile uint32_t count;        // accepted edges
+    volatile uint32_t last_ms;      // HAL_GetTick() of the last edge
+} EXTI_Line_t;
+
+static EXTI_Line_t exti_lines[EXTI_LINES];
+static uint8_t exti_hook_added;
+
+static void exti_tick(void);
+
+/* Record an accepted edge and call the user callback */
+static void exti_deliver(uint8_t line, uint8_t level)
+{
+    EXTI_Line_t *l = &exti_lines[line];
+
+    l->level = level;
+    l->count++;
+    l->last_ms = HAL_GetTick();
+
+    if (l->cb)
+        l->cb(line, level);
+}
+
+/*********************************************************************
+ * @fn      HAL_EXTI_Attach
+ *
+ * @brief   Enables an edge interrupt on a PA/PC/PD pin.
+ *
+ * @param   pin         - Pin descriptor, e.g. PIN(C, 3)
+ * @param   edge        - EXTI_EDGE_RISING, _FALLING or _BOTH
+ * @param   cb          - Callback (interrupt context), may be NULL
+ * @param   debounce_ms - 0 = report every edge; otherwise the line is
+ *                        masked after an edge and the level is sampled
+ *                        once it has been quiet for this long
+ *
+ * @return  uint8_t - 1 on success, 0 for an unsupported pin
+ *
+ * @note    - One pin per line: PC3 and PD3 both use line 3.
+ *          - Configure the pin as input first (e.g. in the pin map).
+ *          - Debounce runs from the SysTick hook, no main-loop cost.
+ */
+uint8_t HAL_EXTI_Attach(GPIO_Pin_t pin, EXTI_Edge_t edge,
+                        EXTI_Callback_t cb, uint16_t debounce_ms)
+{
+    uint8_t line = pin.pin;
+    uint32_t src;
+
+    if (line >= EXTI_LINES)
+        return 0;
+
+    if (pin.port == GPIOA)
+        src = 0x0;
+    else if (pin.port == GPIOC)
+        src = 0x2;
+    else if (pin.port == GPIOD)
+        src = 0x3;
+    else
+        return 0;
+
+    if (!exti_hook_added)
+    {
+        if (!HAL_Tick_AddHook(exti_tick))
+            return 0;
+        exti_hook_added = 1;
+    }
+
+    HAL_EXTI_Detach(line);
+
+    EXTI_Line_t *l = &exti_lines[line];
+    l->pin = pin;
+    l->cb = cb;
+    l->edge = edge;
+    l->debounce_ms = debounce_ms;
+    l->countdown = 0;
+    l->level = pin_read(pin);
+    l->count = 0;
+    l->last_ms = 0;
+
+    RCC->APB2PCENR |= RCC_AFIO;
+
+    /* The ISR and the debounce hook also modify INTENR */
+    uint32_t irq = CRIT_ENTER();
+
+    AFIO->EXTICR = (AFIO->EXTICR & ~(0x3U << (line * 2))) | (src << (line * 2));
+
+    /* With debounce both edges are watched; the settled level decides */
+    if ((edge & EXTI_EDGE_RISING) || debounce_ms)
+        EXTI->RTENR |= (1U << line);
+    if ((edge & EXTI_EDGE_FALLING) || debounce_ms)
+        EXTI->FTENR |= (1U << line);
+
+    EXTI->INTFR = (1U << line);
+    EXTI->INTENR |= (1U << line);
+
+    CRIT_EXIT(irq);
+
+    HAL_PFIC_EnableIRQ(IRQ_EXTI7_0);
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_EXTI_Detach
+ *
+ * @brief   Disables the edge interrupt of a line.
+ *
+ * @param   line - EXTI line (= pin number, 0-7)
+ *
+ * @return  none
+ */
+void HAL_EXTI_Detach(uint8_t line)
+{
+    if (line >= EXTI_LINES)
+        return;
+
+    uint32_t irq = CRIT_ENTER();
+
+    EXTI->INTENR &= ~(1U << line);
+    EXTI->RTENR  &= ~(1U << line);
+    EXTI->FTENR  &= ~(1U << line);
+    EXTI->INTFR   = (1U << line);
+
+    exti_lines[line].cb = NULL;
+    exti_lines[line].countdown = 0;
+
+    CRIT_EXIT(irq);
+}
+
+/*********************************************************************
+ * @fn      HAL_EXTI_GetCount
+ *
+ * @brief   Returns the number of accepted edges on a line.
+ *
+ * @param   line - EXTI line (0-7)
+ *
+ * @return  uint32_t - Edge count since HAL_EXTI_Attach()
+ */
+uint32_t HAL_EXTI_GetCount(uint8_t line)
+{
+    return (line < EXTI_LINES) ? exti_lines[line].count : 0;
+}
+
+/*********************************************************************
+ * @fn      HAL_EXTI_GetLastTime
+ *
+ * @brief   Returns when the last accepted edge happened.
+ *
+ * @param   line - EXTI line (0-7)
+ *
+ * @return  uint32_t - HAL_GetTick() value of the last edge, 0 if none
+ *
+ * @note    With debounce this is the time the level settled.
+ */
+uint32_t HAL_EXTI_GetLastTime(uint8_t line)
+{
+    return (line < EXTI_LINES) ? exti_lines[line].last_ms : 0;
+}
+
+/*********************************************************************
+ * @fn      EXTI7_0_IRQHandler
+ *
+ * @brief   EXTI lines 0-7 interrupt handler.
+ *
+ * @return  none
+ *
+ * @note    - Without debounce the edge is reported at once.
+ *          - With debounce the line is masked and the SysTick hook
+ *            samples the pin when the countdown expires.
+ *          - INTENR is shared with the hook and Attach/Detach, so
+ *            every read-modify-write of it runs masked.
+ */
+void EXTI7_0_IRQHandler(void)
+{
+    IRQ_ENTER();
+
+    uint32_t pending = EXTI->INTFR & EXTI->INTENR & 0xFF;
+
+    EXTI->INTFR = pending;
+
+    for (uint8_t line = 0; pending; line++, pending >>= 1)
+    {
+        if (!(pending & 1))
+            continue;
+
+        EXTI_Line_t *l = &exti_lines[line];
+
+        if (l->debounce_ms)
+        {
+            uint32_t irq = CRIT_ENTER();
+
+            EXTI->INTENR &= ~(1U << line);
+            CRIT_EXIT(irq);
+            l->countdown = l->debounce_ms;
+        }
+        else if (l->edge == EXTI_EDGE_BOTH)
+        {
+            exti_deliver(line, pin_read(l->pin));
+        }
+        else
+        {
+            exti_deliver(line, (l->edge == EXTI_EDGE_RISING) ? 1 : 0);
+        }
+    }
+
+    IRQ_EXIT(IRQ_EXTI7_0);
+}
+
+/*
+ * SysTick hook: finish debounce countdowns. A settled level that
+ * differs from the last one is an edge; it is reported if it matches
+ * the selected edge, then the line is unmasked again.
+ */
+static void exti_tick(void)
+{
+    for (uint8_t line = 0; line < EXTI_LINES; line++)
+    {
+        EXTI_Line_t *l = &exti_lines[line];
+
+        if (!l->countdown || --l->countdown)
+            continue;
+
+        uint8_t level = pin_read(l->pin);
+
+        if (level != l->level)
+        {
+            if (l->edge & (level ? EXTI_EDGE_RISING : EXTI_EDGE_FALLING))
+                exti_deliver(line, level);
+            else
+                l->level = level;
+        }
+
+        /* EXTI (higher priority) may preempt this hook mid-update */
+        uint32_t irq = CRIT_ENTER();
+
+        EXTI->INTFR = (1U << line);
+        EXTI->INTENR |= (1U << line);
+        CRIT_EXIT(irq);
+    }
+}
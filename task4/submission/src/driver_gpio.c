@@ -1,5 +1,7 @@
 #include <stdint.h>
 #include <driver_gpio.h>
+#include <driver_gpio_pin.h>
+#include <driver_rcc.h>
 
 /*********************************************************************
  * @fn      HAL_GPIO_Init
@@ -36,13 +38,15 @@ void HAL_GPIO_Init(GPIO_RegDef_t *GPIOx, uint8_t pin, GPIO_Mode_t mode, GPIO_CNF
  * @param   state - Pin state: 0 = LOW, 1 = HIGH
  *
  * @return  none
+ *
+ * @note    - Single store to BSHR/BCR: no read-modify-write of OUTDR,
+ *            so an ISR touching other pins of the port cannot be undone.
+ *          - Run-time wrapper over pin_write(); with a constant pin use
+ *            pin_set()/pin_clr() from driver_gpio_pin.h directly.
  */
 void HAL_GPIO_WritePin(GPIO_RegDef_t *GPIOx, uint8_t pin, uint8_t state)
 {
-    if(state)
-        GPIOx->OUTDR |= (1 << pin);    // Set pin HIGH
-    else
-        GPIOx->OUTDR &= ~(1 << pin);   // Set pin LOW
+    pin_write(PIN_RT(GPIOx, pin), state);
 }
 
 /*********************************************************************
@@ -54,10 +58,14 @@ void HAL_GPIO_WritePin(GPIO_RegDef_t *GPIOx, uint8_t pin, uint8_t state)
  * @param   pin   - Pin number to toggle (0-7)
  *
  * @return  none
+ *
+ * @note    - Reads OUTDR once, then sets or resets the pin with a single
+ *            BSHR store, so other pins of the port are never written.
+ *          - Run-time wrapper over pin_toggle().
  */
 void HAL_GPIO_TogglePin(GPIO_RegDef_t *GPIOx, uint8_t pin)
 {
-    GPIOx->OUTDR ^= (1 << pin);  // XOR to toggle the pin
+    pin_toggle(PIN_RT(GPIOx, pin));
 }
 
 /*********************************************************************
@@ -69,10 +77,106 @@ void HAL_GPIO_TogglePin(GPIO_RegDef_t *GPIOx, uint8_t pin)
  * @param   pin   - Pin number to read (0-15)
  *
  * @return  uint8_t - Pin state: 0 = LOW, 1 = HIGH
+ *
+ * @note    Run-time wrapper over pin_read().
  */
 uint8_t HAL_GPIO_ReadPin(GPIO_RegDef_t *GPIOx, uint8_t pin)
 {
-    return (GPIOx->INDR >> pin) & 0x1;  // Shift and mask to get pin value
+    return pin_read(PIN_RT(GPIOx, pin));
+}
+
+/*********************************************************************
+ * @fn      HAL_GPIO_WritePort
+ *
+ * @brief   Sets and clears several pins of a port in one bus write.
+ *
+ * @param   GPIOx     - Pointer to the GPIO peripheral
+ * @param   setMask   - Pins to drive HIGH (bit n = pin n)
+ * @param   clearMask - Pins to drive LOW (bit n = pin n)
+ *
+ * @return  none
+ *
+ * @note    - One atomic BSHR store; pins in neither mask are untouched.
+ *          - If a pin is in both masks, set wins (hardware priority).
+ */
+void HAL_GPIO_WritePort(GPIO_RegDef_t *GPIOx, uint16_t setMask, uint16_t clearMask)
+{
+    GPIOx->BSHR = ((uint32_t)clearMask << 16) | setMask;
+}
+
+/*********************************************************************
+ * @fn      HAL_GPIO_ReadPort
+ *
+ * @brief   Reads the input level of all pins of a port at once.
+ *
+ * @param   GPIOx - Pointer to the GPIO peripheral
+ *
+ * @return  uint16_t - Pin levels (bit n = pin n)
+ */
+uint16_t HAL_GPIO_ReadPort(GPIO_RegDef_t *GPIOx)
+{
+    return (uint16_t)GPIOx->INDR;
 }
 
+/*********************************************************************
+ * @fn      HAL_GPIO_InitTable
+ *
+ * @brief   Configures every pin of a board pin map in one pass.
+ *
+ * @param   table - Pin map (usually a const array in flash)
+ * @param   count - Number of entries
+ *
+ * @return  none
+ *
+ * @note    - Merges all MODE/CNF nibbles per port first, then applies:
+ *              one APB2PCENR write for all needed port clocks,
+ *              one BSHR write per port for initial levels / pulls,
+ *              one CFGLR write per port.
+ *          - Levels are written before CFGLR so outputs come up in
+ *            their initial state without a glitch.
+ *          - Pins not in the table keep their configuration.
+ */
+void HAL_GPIO_InitTable(const GPIO_PinConfig_t *table, uint8_t count)
+{
+    static GPIO_RegDef_t *const ports[3] = { GPIOA, GPIOC, GPIOD };
+    static const uint32_t clocks[3] = { RCC_GPIOA, RCC_GPIOC, RCC_GPIOD };
+
+    uint32_t cfg_mask[3] = { 0 };
+    uint32_t cfg_val[3]  = { 0 };
+    uint32_t bshr[3]     = { 0 };
+    uint32_t clk = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const GPIO_PinConfig_t *e = &table[i];
+        uint8_t p = 0;
+
+        while (p < 3 && ports[p] != e->pin.port)
+            p++;
+        if (p == 3)
+            continue;
+
+        uint8_t shift = e->pin.pin * 4;
+        uint32_t nib = ((e->cnf << 2) | e->mode) & 0xF;
+
+        cfg_mask[p] |= (0xFU << shift);
+        cfg_val[p]   = (cfg_val[p] & ~(0xFU << shift)) | (nib << shift);
 
+        /* Set bit (low half) or reset bit (high half) of BSHR */
+        bshr[p] &= ~(0x10001U << e->pin.pin);
+        bshr[p] |= e->level ? (1U << e->pin.pin) : (1U << (e->pin.pin + 16));
+
+        clk |= clocks[p];
+    }
+
+    RCC->APB2PCENR |= clk;
+
+    for (uint8_t p = 0; p < 3; p++)
+    {
+        if (!cfg_mask[p])
+            continue;
+
+        ports[p]->BSHR  = bshr[p];
+        ports[p]->CFGLR = (ports[p]->CFGLR & ~cfg_mask[p]) | cfg_val[p];
+    }
+}
@@ -0,0 +1,216 @@
+#include "driver_pfic.h"
+#include "driver_rcc.h"
+
+/* SysTick->CNT sampled on entry to SW_Handler */
+static volatile uint32_t sw_entry_cnt;
+static volatile uint8_t sw_entered;
+
+/*********************************************************************
+ * @fn      HAL_PFIC_EnableIRQ
+ *
+ * @brief   Enables the specified interrupt in the PFIC.
+ *
+ * @param   irq - Interrupt number (IRQn_t)
+ *
+ * @return  none
+ *
+ * @note    IENR is write-1-to-set, so no read-modify-write is needed.
+ */
+void HAL_PFIC_EnableIRQ(IRQn_t irq)
+{
+    PFIC->IENR[irq >> 5] = (1U << (irq & 0x1F));
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_DisableIRQ
+ *
+ * @brief   Disables the specified interrupt in the PFIC.
+ *
+ * @param   irq - Interrupt number (IRQn_t)
+ *
+ * @return  none
+ *
+ * @note    IRER is write-1-to-clear, so no read-modify-write is needed.
+ */
+void HAL_PFIC_DisableIRQ(IRQn_t irq)
+{
+    PFIC->IRER[irq >> 5] = (1U << (irq & 0x1F));
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_SetPriority
+ *
+ * @brief   Sets the priority of an interrupt.
+ *
+ * @param   irq  - Interrupt number (IRQn_t)
+ * @param   prio - 0 (highest) to 3 (lowest)
+ *
+ * @return  none
+ *
+ * @note    - Only IPRIOR bits 7:6 are implemented.
+ *          - With nesting enabled, prio 0-1 preempt handlers of
+ *            prio 2-3; within a group the lower value wins when
+ *            both are pending.
+ */
+void HAL_PFIC_SetPriority(IRQn_t irq, uint8_t prio)
+{
+    PFIC->IPRIOR[irq] = (uint8_t)((prio & 0x3) << 6);
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_SetPending
+ *
+ * @brief   Triggers an interrupt from software.
+ *
+ * @param   irq - Interrupt number (IRQn_t)
+ *
+ * @return  none
+ *
+ * @note    IPSR is write-1-to-set.
+ */
+void HAL_PFIC_SetPending(IRQn_t irq)
+{
+    PFIC->IPSR[irq >> 5] = (1U << (irq & 0x1F));
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_Config
+ *
+ * @brief   Enables hardware prologue/epilogue and/or nesting.
+ *
+ * @param   flags - PFIC_HPE, PFIC_NEST (others are turned off)
+ *
+ * @return  none
+ *
+ * @note    - Writes INTSYSCR (CSR 0x804); call before enabling IRQs.
+ *          - HPE saves the caller-saved registers in hardware on entry
+ *            (two nesting levels deep).
+ *          - Handlers built with PFIC_FAST_HANDLERS require PFIC_HPE.
+ */
+void HAL_PFIC_Config(uint8_t flags)
+{
+#if defined(__riscv)
+    uint32_t v;
+
+    __asm volatile ("csrr %0, 0x804" : "=r"(v));
+    v = (v & ~0x3U) | (flags & (PFIC_HPE | PFIC_NEST));
+    __asm volatile ("csrw 0x804, %0" :: "r"(v));
+#else
+    (void)flags;
+#endif
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_SetVTF
+ *
+ * @brief   Gives an interrupt a vector-table-free fast slot.
+ *
+ * @param   slot    - 0 or 1
+ * @param   irq     - Interrupt number (IRQn_t)
+ * @param   handler - Handler function (the normal IRQ_HANDLER)
+ *
+ * @return  uint8_t - 1 on success, 0 for an invalid slot
+ *
+ * @note    - The PFIC jumps to the address directly instead of loading
+ *            it from the vector table, saving the table fetch.
+ *          - Bit 0 of VTFADDR enables the slot (handlers are at least
+ *            2-byte aligned, so the bit is free).
+ */
+uint8_t HAL_PFIC_SetVTF(uint8_t slot, IRQn_t irq, void (*handler)(void))
+{
+    if (slot >= PFIC_VTF_SLOTS)
+        return 0;
+
+    PFIC->VTFADDR[slot] = 0;
+    PFIC->VTFIDR[slot] = (uint8_t)irq;
+    PFIC->VTFADDR[slot] = (uint32_t)(uintptr_t)handler | 1U;
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_ClearVTF
+ *
+ * @brief   Releases a VTF slot; the IRQ uses the vector table again.
+ *
+ * @param   slot - 0 or 1
+ *
+ * @return  none
+ */
+void HAL_PFIC_ClearVTF(uint8_t slot)
+{
+    if (slot < PFIC_VTF_SLOTS)
+        PFIC->VTFADDR[slot] = 0;
+}
+
+/*********************************************************************
+ * @fn      SW_Handler
+ *
+ * @brief   Software interrupt: records SysTick->CNT on entry.
+ *
+ * @return  none
+ */
+void SW_Handler(void)
+{
+    sw_entry_cnt = SysTick->CNT;
+    sw_entered = 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_PFIC_MeasureLatency
+ *
+ * @brief   Measures interrupt entry latency with the current settings.
+ *
+ * @param   use_vtf - 1 = route the software IRQ through VTF slot
+ *                    PFIC_VTF_SLOTS-1 for the measurement (the slot's
+ *                    own IRQ is restored afterwards)
+ *
+ * @return  uint32_t - Cycles from setting the IRQ pending to the first
+ *                     instruction of SW_Handler's body, 0 on failure
+ *
+ * @note    - Needs HAL_Delay_Init() (SysTick counting HCLK).
+ *          - Includes the software prologue of SW_Handler, so it shows
+ *            the gain from PFIC_HPE/PFIC_FAST_HANDLERS as well as VTF.
+ *          - The cost of reading SysTick->CNT is measured first and
+ *            subtracted.
+ *          - Run with other interrupts quiet for a stable number.
+ */
+uint32_t HAL_PFIC_MeasureLatency(uint8_t use_vtf)
+{
+    uint32_t reload = SysTick->CMP + 1;
+    uint32_t c0, c1, t0, lat;
+    uint8_t  saved_id   = PFIC->VTFIDR[PFIC_VTF_SLOTS - 1];
+    uint32_t saved_addr = PFIC->VTFADDR[PFIC_VTF_SLOTS - 1];
+
+    if (use_vtf)
+        HAL_PFIC_SetVTF(PFIC_VTF_SLOTS - 1, IRQ_SW, SW_Handler);
+
+    HAL_PFIC_EnableIRQ(IRQ_SW);
+
+    /* Overhead of two back-to-back counter reads */
+    c0 = SysTick->CNT;
+    c1 = SysTick->CNT;
+
+    sw_entered = 0;
+    t0 = SysTick->CNT;
+    HAL_PFIC_SetPending(IRQ_SW);
+
+    for (uint32_t i = 0; !sw_entered && i < 10000; i++)
+        ;
+
+    HAL_PFIC_DisableIRQ(IRQ_SW);
+
+    if (use_vtf)
+    {
+        PFIC->VTFADDR[PFIC_VTF_SLOTS - 1] = 0;
+        PFIC->VTFIDR[PFIC_VTF_SLOTS - 1] = saved_id;
+        PFIC->VTFADDR[PFIC_VTF_SLOTS - 1] = saved_addr;
+    }
+
+    if (!sw_entered)
+        return 0;
+
+    lat = (sw_entry_cnt >= t0) ? sw_entry_cnt - t0 : sw_entry_cnt + reload - t0;
+    c1  = (c1 >= c0) ? c1 - c0 : c1 + reload - c0;
+
+    return (lat > c1) ? lat - c1 : 0;
+}
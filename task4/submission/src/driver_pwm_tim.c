@@ -0,0 +1,39 @@
+#include "driver_pwm_tim.h"
+
+/*********************************************************************
+ * @fn      HAL_TIM_SetUpdateRate
+ *
+ * @brief   Programs a timer to generate update events at rate_hz.
+ *
+ * @param   TIMx     TIM1 or TIM2 (clock enabled, counter stopped).
+ * @param   rate_hz  Update event rate in Hertz (not 0).
+ *
+ * @formulas
+ *          ticks = SystemCoreClock / rate_hz   (rounded)
+ *          PSC   = ticks / 65536
+ *          ARR   = ticks / (PSC + 1) − 1
+ *
+ * @note    - Smallest prescaler that fits, so ARR keeps the most
+ *            resolution.
+ *          - Generates UG to load PSC, then clears the update flag
+ *            and the counter. Enable DMA requests afterwards or the
+ *            UG event triggers one.
+ *
+ * @return  none
+ *********************************************************************/
+void HAL_TIM_SetUpdateRate(TIM_RegDef_t *TIMx, uint32_t rate_hz)
+{
+    uint32_t ticks = (SystemCoreClock + (rate_hz >> 1)) / rate_hz;
+    uint32_t psc;
+
+    if (ticks == 0)
+        ticks = 1;
+
+    psc = ticks >> 16;
+
+    TIMx->PSC    = psc;
+    TIMx->ATRLR  = ticks / (psc + 1) - 1;
+    TIMx->SWEVGR = TIM_SWEVGR_UG;
+    TIMx->INTFR  = 0;
+    TIMx->CNT    = 0;
+}
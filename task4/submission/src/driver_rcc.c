@@ -1,4 +1,5 @@
 #include "driver_rcc.h"
+#include "critical.h"
 
 /*********************************************************************
  * @fn      HAL_RCC_APB2_Enable
@@ -35,18 +36,66 @@ void HAL_RCC_APB2_Disable(RCC_APB2Periph_t periph)
  */
 volatile uint32_t ms_ticks = 0;
 
+/* Microseconds at the last tick (64-bit, never wraps in practice) */
+static volatile uint64_t tick_us;
+
+/* HCLK cycles at the last tick (wraps; compare as differences) */
+static volatile uint32_t tick_cycles;
+
+/* Driver tick hooks (debounce, software timers, ...) */
+static HAL_TickHook_t tick_hooks[TICK_HOOK_MAX];
+static uint8_t tick_hook_count;
+
+/* SysTick counts per millisecond / microsecond at the current clock */
+static uint32_t ticks_per_ms = SYSCLK / 1000;
+static uint32_t ticks_per_us = SYSCLK / 1000000;
+
 /*********************************************************************
  * @fn      SysTick_Handler
  *
  * @brief   SysTick interrupt handler. Increments the millisecond counter.
  *
- * @note    This handler is automatically called every SysTick interrupt.
+ * @note    - Runs every 1ms once HAL_Delay_Init() has been called.
+ *          - Clears the compare flag (CNTIF) in SR.
+ *          - Then runs the hooks added with HAL_Tick_AddHook().
  *
  * @return  none
  */
 void SysTick_Handler(void)
 {
+    IRQ_ENTER();
+
+    SysTick->SR = 0;
     ms_ticks++;
+    tick_us += 1000;
+    tick_cycles += ticks_per_ms;
+
+    for (uint8_t i = 0; i < tick_hook_count; i++)
+        tick_hooks[i]();
+
+    IRQ_EXIT(IRQ_SYSTICK);
+}
+
+/*********************************************************************
+ * @fn      HAL_Tick_AddHook
+ *
+ * @brief   Adds a function to be called from SysTick_Handler every 1ms.
+ *
+ * @param   fn - Hook function (runs in interrupt context, keep it short)
+ *
+ * @return  uint8_t - 1 on success, 0 if all TICK_HOOK_MAX slots are used
+ *
+ * @note    Intended for drivers (debounce, timers); hooks cannot be
+ *          removed.
+ */
+uint8_t HAL_Tick_AddHook(HAL_TickHook_t fn)
+{
+    if (tick_hook_count == TICK_HOOK_MAX)
+        return 0;
+
+    tick_hooks[tick_hook_count] = fn;
+    tick_hook_count++;
+    return 1;
 }
 
 /*********************************************************************
@@ -54,20 +103,117 @@ void SysTick_Handler(void)
  *
  * @brief   Initializes the SysTick timer for 1ms tick generation.
  *
- * @note    Sets up SysTick without enabling interrupts. For interrupt-
- *          based delays, ensure the NVIC exception is enabled.
+ * @note    - Counts HCLK, reloads to 0 every SystemCoreClock/1000
+ *            counts and interrupts on each reload.
+ *          - Call again after changing the system clock; the tick
+ *            count is kept so time stays continuous.
  *
  * @return  none
  */
 void HAL_Delay_Init(void)
 {
-    ms_ticks = 0;
-    SysTick->CMP = SYSCLK / 1000 - 1;  // 1ms tick
-    SysTick->CNT = 0;
-    SysTick->CTLR = 5; // enable SysTick with processor clock, interrupts off
+    ticks_per_ms = SystemCoreClock / 1000;
+    ticks_per_us = SystemCoreClock / 1000000;
 
-    // For interrupt-based delay, enable the IRQ in NVIC
-    // CH32V003: usually SysTick exception is always active
+    SysTick->CTLR = 0;
+    SysTick->SR   = 0;
+    SysTick->CMP  = ticks_per_ms - 1;  // 1ms tick
+    SysTick->CNT  = 0;
+    SysTick->CTLR = SYSTICK_STE | SYSTICK_STIE | SYSTICK_STCLK | SYSTICK_STRE;
+
+    HAL_PFIC_EnableIRQ(IRQ_SYSTICK);
+}
+
+/*********************************************************************
+ * @fn      HAL_GetTick
+ *
+ * @brief   Returns milliseconds since HAL_Delay_Init().
+ *
+ * @return  uint32_t - Millisecond count (wraps after ~49.7 days)
+ *
+ * @note    Compare times as (now - start) so wrap-around is harmless.
+ */
+uint32_t HAL_GetTick(void)
+{
+    return ms_ticks;
+}
+
+/*********************************************************************
+ * @fn      HAL_GetMicros
+ *
+ * @brief   Returns microseconds since HAL_Delay_Init().
+ *
+ * @return  uint64_t - Microsecond count (does not wrap)
+ *
+ * @note    - Combines the tick count with SysTick->CNT. Re-reads if a
+ *            tick interrupt happened in between, and accounts for a
+ *            reload whose interrupt is still pending (IRQs masked).
+ *          - Resolution is 1us.
+ */
+uint64_t HAL_GetMicros(void)
+{
+    uint32_t ms, cnt;
+    uint64_t base;
+
+    do
+    {
+        ms   = ms_ticks;
+        base = tick_us;
+        cnt  = SysTick->CNT;
+    } while (ms != ms_ticks);
+
+    /* Counter reloaded but the tick interrupt has not run yet */
+    if ((SysTick->SR & SYSTICK_CNTIF) && cnt < (ticks_per_ms >> 1))
+        base += 1000;
+
+    return base + cnt / ticks_per_us;
+}
+
+/*********************************************************************
+ * @fn      HAL_GetCycles
+ *
+ * @brief   Returns HCLK cycles since HAL_Delay_Init().
+ *
+ * @return  uint32_t - Cycle count (wraps, every 179 s at 24 MHz)
+ *
+ * @note    - Same read sequence as HAL_GetMicros(), but adds and
+ *            compares only: no divide, so it is cheap enough to time
+ *            every scheduler dispatch.
+ *          - Compare as (now - start); convert for display with
+ *            HAL_CyclesToMicros().
+ */
+uint32_t HAL_GetCycles(void)
+{
+    uint32_t ms, cnt, base;
+
+    do
+    {
+        ms   = ms_ticks;
+        base = tick_cycles;
+        cnt  = SysTick->CNT;
+    } while (ms != ms_ticks);
+
+    /* Counter reloaded but the tick interrupt has not run yet */
+    if ((SysTick->SR & SYSTICK_CNTIF) && cnt < (ticks_per_ms >> 1))
+        base += ticks_per_ms;
+
+    return base + cnt;
+}
+
+/*********************************************************************
+ * @fn      HAL_CyclesToMicros
+ *
+ * @brief   Converts a HAL_GetCycles() difference to microseconds.
+ *
+ * @param   cycles - HCLK cycles
+ *
+ * @return  uint32_t - Microseconds, rounded down
+ *
+ * @note    One software divide; meant for printing, not hot paths.
+ */
+uint32_t HAL_CyclesToMicros(uint32_t cycles)
+{
+    return cycles / ticks_per_us;
 }
 
 /*********************************************************************
@@ -79,37 +225,68 @@ void HAL_Delay_Init(void)
  *
  * @return  none
  *
- * @note    Uses a simple busy-wait loop. Accuracy depends on CPU clock.
+ * @note    - Waits on the SysTick millisecond counter, so the delay is
+ *            independent of clock speed and optimisation level.
+ *          - Waits ms+1 ticks so the delay is never shorter than asked
+ *            (the current tick may be partly over).
+ *          - Requires interrupts enabled.
  */
 void HAL_Delay_ms(uint32_t ms)
 {
-    #if 1
-    for (uint32_t i = 0; i < ms; i++)
-        for (volatile uint32_t j = 0; j < 8000; j++); // ~1ms
-    #endif
-
-    #if 0
-    uint32_t start = ms_ticks;
-    while ((ms_ticks - start) < ms);
-    #endif
+    uint32_t start = HAL_GetTick();
+
+    if (ms < UINT32_MAX)
+        ms++;
+
+    while ((HAL_GetTick() - start) < ms);
 }
 
 
+/* a * b for a small b (ticks per us), shift/add only: RV32EC has no mul */
+static uint32_t mul_small(uint32_t a, uint32_t b)
+{
+    uint32_t r = 0;
+
+    while (b)
+    {
+        if (b & 1)
+            r += a;
+        a <<= 1;
+        b >>= 1;
+    }
+
+    return r;
+}
+
 /*********************************************************************
  * @fn      HAL_Delay_us
  *
  * @brief   Provides a blocking delay for a specified number of microseconds.
  *
- * @param   us - Number of microseconds to delay
+ * @param   us - Number of microseconds to delay (up to ~178 s at 24 MHz)
  *
  * @return  none
  *
- * @note    Uses a busy-wait loop based on CPU cycles. Approximate delay.
+ * @note    - Counts elapsed HCLK cycles on SysTick->CNT, handling the
+ *            1ms reload, so loop overhead does not add up with 'us'.
+ *          - Never shorter than asked; overshoot is bounded by the
+ *            call overhead plus one polling pass (well under 1us at
+ *            24 MHz).
+ *          - Works with interrupts masked, as long as no single ISR
+ *            runs for longer than 1ms.
+ *          - For waits below 1us use HAL_Delay_Cycles().
  */
 void HAL_Delay_us(uint32_t us)
 {
-    uint32_t ticks = (SYSCLK / 1000000UL) * us;
-    while (ticks--)
-        __asm volatile("nop");
-}
+    uint32_t prev = SysTick->CNT;
+    uint32_t target = mul_small(us, ticks_per_us);
+    uint32_t elapsed = 0;
 
+    while (elapsed < target)
+    {
+        uint32_t now = SysTick->CNT;
+
+        elapsed += (now >= prev) ? (now - prev) : (now + ticks_per_ms - prev);
+        prev = now;
+    }
+}
@@ -1,29 +1,108 @@
 #include <driver_usart_debug.h>
+#include <driver_gpio_pin.h>
+#include "critical.h"
+#include <stdarg.h>
+
+#if (UART_TX_BUF_SIZE & (UART_TX_BUF_SIZE - 1)) != 0
+#error "UART_TX_BUF_SIZE must be a power of two"
+#endif
+
+#if (UART_RX_BUF_SIZE & (UART_RX_BUF_SIZE - 1)) != 0
+#error "UART_RX_BUF_SIZE must be a power of two"
+#endif
+
+#define TX_MASK (UART_TX_BUF_SIZE - 1)
+#define RX_MASK (UART_RX_BUF_SIZE - 1)
+
+/* USART1 pins (default mapping) */
+static const GPIO_PinConfig_t uart_pins[] =
+{
+    { PIN(D, 5), GPIO_MODE_OUTPUT_50MHz, GPIO_CNF_AF_PUSH_PULL, 1 },    // TX
+    { PIN(D, 6), GPIO_MODE_INPUT,        GPIO_CNF_IN_FLOATING,  0 },    // RX
+};
+
+/*
+ * TX ring buffer. Indices run freely and are masked on access, so
+ * (head - tail) is the fill level. head is only written by the
+ * producer (main loop), tail only by the consumer (USART1 ISR).
+ */
+static volatile char     tx_buf[UART_TX_BUF_SIZE];
+static volatile uint16_t tx_head;
+static volatile uint16_t tx_tail;
+static volatile uint32_t tx_dropped;
+static UART_TxPolicy_t   tx_policy = UART_TX_BLOCK;
+
+/* DMA transfer state; the TX buffer waits while DMA owns DATAR */
+static volatile uint8_t  tx_dma_busy;
+static UART_TxDoneCallback_t tx_done_cb;
+
+/*
+ * RX ring buffer, same scheme with the roles swapped: head is written
+ * by the USART1 ISR, tail by the main loop.
+ */
+static volatile char     rx_buf[UART_RX_BUF_SIZE];
+static volatile uint16_t rx_head;
+static volatile uint16_t rx_tail;
+static volatile uint32_t rx_dropped;
+static UART_RxCallback_t rx_cb;
+static volatile uint8_t  rx_idle;
+
+/* Line editor state for HAL_UART_TryReadLine() */
+static uint8_t rx_line_len;
+static char    rx_last;
+
+/* Number of free bytes in the TX buffer */
+static uint16_t uart_tx_free(void)
+{
+    return UART_TX_BUF_SIZE - (uint16_t)(tx_head - tx_tail);
+}
+
+/*
+ * Store one byte (caller checked space) and arm the TXE interrupt.
+ * While a DMA transfer runs the byte stays queued; the DMA ISR arms
+ * TXE when it finishes.
+ */
+static void uart_tx_put(char c)
+{
+    tx_buf[tx_head & TX_MASK] = c;
+    tx_head++;
+
+    if (!tx_dma_busy)
+        USART1->CTLR1 |= USART_TXEIE;
+}
 
 /*********************************************************************
  * @fn      HAL_UART_Init
  *
  * @brief   Initializes USART1 peripheral and configures GPIO for TX.
  *
- * @note    - Enables clocks for GPIOD and USART1.
+ * @note    - Enables clocks for GPIOD, USART1 and DMA1.
  *          - Configures PD5 as USART1_TX (AF push-pull, 50MHz).
  *          - Sets baud rate to 115200 @ 24MHz system clock.
  *          - Enables transmitter and USART1.
+ *          - Empties the TX/RX buffers, enables RXNE/IDLE interrupts
+ *            and the USART1 IRQ in the PFIC.
  *
  * @return  none
  */
 void HAL_UART_Init(void)
 {
-    /* Enable clocks: GPIOD + USART1 */
-    RCC->APB2PCENR |= (1 << 5) | (1 << 14); // IOPD + USART1
+    tx_head = 0;
+    tx_tail = 0;
+    tx_dropped = 0;
+    tx_dma_busy = 0;
+    rx_head = 0;
+    rx_tail = 0;
+    rx_dropped = 0;
+    rx_idle = 0;
+    rx_line_len = 0;
 
-    /* PD5 → USART1_TX (AF push-pull, 50MHz) */
-    GPIOD->CFGLR &= ~(0xF << (5*4));
-    GPIOD->CFGLR |=  (0xB << (5*4));
+    /* Enable clocks: USART1, DMA1 (GPIOD comes with the pin table) */
+    RCC->APB2PCENR |= RCC_USART1EN;
+    RCC->AHBPCENR  |= RCC_DMA1EN;
 
-    /* PD6 → USART1_RX (Input Floating) */
-    GPIOD->CFGLR &= ~(0xF << (6*4));
-    GPIOD->CFGLR |=  (0x4 << (6*4));   // input floating
+    /* PD5 → USART1_TX (AF push-pull, 50MHz), PD6 → USART1_RX (floating) */
+    HAL_GPIO_InitTable(uart_pins, sizeof(uart_pins) / sizeof(uart_pins[0]));
 
     /* Baudrate: 115200 @ 24MHz */
     USART1->BRR = SYSCLK / 115200;
@@ -31,24 +110,43 @@ void HAL_UART_Init(void)
     /* Enable TX + RX + USART */
     USART1->CTLR1 |= (1 << 3) | (1 << 2) | (1 << 13); // TE + RE + UE
 
+    /* Receive by interrupt: every byte plus end-of-burst (idle line) */
+    USART1->CTLR1 |= USART_RXNEIE | USART_IDLEIE;
+
+    /* USART1_TX DMA requests: channel 4, memory → DATAR */
+    DMA1_CH(DMA_CH_USART1_TX)->PADDR = (uint32_t)(uintptr_t)&USART1->DATAR;
+    USART1->CTLR3 |= USART_DMAT;
+
+    HAL_PFIC_EnableIRQ(IRQ_USART1);
+    HAL_PFIC_EnableIRQ(IRQ_DMA1_CH4);
 }
 
 
 /*********************************************************************
  * @fn      HAL_UART_SendChar
  *
- * @brief   Sends a single character over USART1.
+ * @brief   Queues a single character for transmission over USART1.
  *
  * @param   c - Character to send
  *
  * @return  none
  *
- * @note    Waits until TXE (transmit data register empty) flag is set.
+ * @note    - Returns as soon as the byte is in the TX buffer.
+ *          - When the buffer is full, UART_TX_BLOCK waits for the ISR
+ *            to free a slot; the other policies drop the byte.
  */
 void HAL_UART_SendChar(char c)
 {
-    while (!(USART1->STATR & (1 << 7))); // wait TXE
-    USART1->DATAR = c;
+    while (uart_tx_free() == 0)
+    {
+        if (tx_policy != UART_TX_BLOCK)
+        {
+            tx_dropped++;
+            return;
+        }
+    }
+
+    uart_tx_put(c);
 }
 
 /*********************************************************************
@@ -58,86 +156,561 @@ void HAL_UART_SendChar(char c)
  *
  * @return  char - The received character
  *
- * @note    - Waits until RXNE (Receive Data Register Not Empty) flag is set.
+ * @note    - Waits until the RX buffer holds at least one byte.
  *          - Blocking function (waits indefinitely until data arrives).
+ *          - Use HAL_UART_TryReadChar() from the super-loop instead.
  */
 char HAL_UART_ReadChar(void)
 {
-    while (!(USART1->STATR & (1 << 5))); // RXNE flag
-    return (char)USART1->DATAR;
+    char c;
+
+    while (!HAL_UART_TryReadChar(&c));
+    return c;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_TryReadChar
+ *
+ * @brief   Takes one character from the RX buffer if available.
+ *
+ * @param   c - Where to store the character
+ *
+ * @return  uint8_t - 1 if a character was read, 0 if the buffer is empty
+ */
+uint8_t HAL_UART_TryReadChar(char *c)
+{
+    if (rx_tail == rx_head)
+        return 0;
+
+    *c = rx_buf[rx_tail & RX_MASK];
+    rx_tail++;
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_Available
+ *
+ * @brief   Returns the number of received bytes waiting in the RX buffer.
+ *
+ * @return  uint16_t - Byte count (0 to UART_RX_BUF_SIZE)
+ */
+uint16_t HAL_UART_Available(void)
+{
+    return (uint16_t)(rx_head - rx_tail);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_RxIdle
+ *
+ * @brief   Reports (and clears) an idle-line event.
+ *
+ * @return  uint8_t - 1 if the line went idle after a burst of data
+ *                    since the last call, 0 otherwise
+ *
+ * @note    An idle line (one frame time with no data) marks the end of
+ *          a message or paste, so binary or unterminated input can be
+ *          handled as one unit once this returns 1.
+ */
+uint8_t HAL_UART_RxIdle(void)
+{
+    if (!rx_idle)
+        return 0;
+
+    rx_idle = 0;
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_GetRxDropped
+ *
+ * @brief   Returns the number of received bytes lost to a full RX
+ *          buffer or a hardware overrun.
+ *
+ * @return  uint32_t - Lost byte count since HAL_UART_Init()
+ */
+uint32_t HAL_UART_GetRxDropped(void)
+{
+    return rx_dropped;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_SetRxCallback
+ *
+ * @brief   Registers a function called when RX data arrives.
+ *
+ * @param   cb - Callback, or NULL to disable
+ *
+ * @return  none
+ *
+ * @note    - Runs in interrupt context after each received byte and
+ *            on idle line; use it to wake up the reader, not to read.
+ */
+void HAL_UART_SetRxCallback(UART_RxCallback_t cb)
+{
+    rx_cb = cb;
 }
 
 /*********************************************************************
  * @fn      HAL_UART_SendString
  *
- * @brief   Sends a null-terminated string over USART1.
+ * @brief   Queues a null-terminated string for transmission over USART1.
  *
  * @param   s - Pointer to the string to transmit
  *
  * @return  none
  *
- * @note    - Sends characters one by one using HAL_UART_SendChar().
- *          - Stops transmission when '\0' is reached.
+ * @note    - Returns once the string is in the TX buffer.
+ *          - Buffer-full handling follows the policy set with
+ *            HAL_UART_SetTxPolicy():
+ *              UART_TX_BLOCK    → waits for space
+ *              UART_TX_DROP     → drops the whole string if it won't fit
+ *              UART_TX_TRUNCATE → queues what fits, drops the rest
+ *          - Dropped bytes are counted (see HAL_UART_GetDropped()).
  */
 void HAL_UART_SendString(const char *s)
 {
-    while (*s)
-        HAL_UART_SendChar(*s++);
+    if (tx_policy == UART_TX_BLOCK)
+    {
+        while (*s)
+            HAL_UART_SendChar(*s++);
+        return;
+    }
+
+    uint16_t len = 0;
+    while (s[len])
+        len++;
+
+    uint16_t room = uart_tx_free();
+
+    if (len > room)
+    {
+        if (tx_policy == UART_TX_DROP)
+        {
+            tx_dropped += len;
+            return;
+        }
+
+        tx_dropped += len - room;
+        len = room;
+    }
+
+    while (len--)
+        uart_tx_put(*s++);
 }
 
 /*********************************************************************
- * @fn      HAL_UART_ReadLine
+ * @fn      HAL_UART_SetTxPolicy
  *
- * @brief   Reads a line of text from USART1 until ENTER is pressed.
+ * @brief   Selects what happens when the TX buffer is full.
+ *
+ * @param   policy - UART_TX_BLOCK, UART_TX_DROP or UART_TX_TRUNCATE
+ *
+ * @return  none
+ *
+ * @note    UART_TX_BLOCK (default) must not be used with interrupts
+ *          disabled, since only the USART1 ISR frees buffer space.
+ */
+void HAL_UART_SetTxPolicy(UART_TxPolicy_t policy)
+{
+    tx_policy = policy;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_Flush
+ *
+ * @brief   Waits until every queued byte has left the shift register.
+ *
+ * @return  none
+ *
+ * @note    Use before changing clocks, sleeping or resetting.
+ */
+void HAL_UART_Flush(void)
+{
+    while (tx_dma_busy);
+    while (tx_tail != tx_head);
+    while (!(USART1->STATR & USART_TC));
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_GetDropped
+ *
+ * @brief   Returns the number of bytes discarded because the TX
+ *          buffer was full.
+ *
+ * @return  uint32_t - Dropped byte count since HAL_UART_Init()
+ */
+uint32_t HAL_UART_GetDropped(void)
+{
+    return tx_dropped;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_SendBuffer
+ *
+ * @brief   Starts a DMA transfer of a whole buffer to USART1.
+ *
+ * @param   buf - Data to send
+ * @param   len - Number of bytes (1-65535)
+ *
+ * @return  uint8_t - 1 if the transfer was started, 0 if DMA is busy
+ *                    or len is 0
+ *
+ * @note    - Returns immediately; the buffer must stay valid and
+ *            unchanged until HAL_UART_TxBusy() returns 0 or the
+ *            completion callback runs.
+ *          - Waits for already queued TX buffer bytes to go out first,
+ *            so output order is preserved.
+ */
+uint8_t HAL_UART_SendBuffer(const uint8_t *buf, uint16_t len)
+{
+    DMA_Channel_RegDef_t *ch = DMA1_CH(DMA_CH_USART1_TX);
+
+    if (tx_dma_busy || len == 0)
+        return 0;
+
+    /* Let the TXE interrupt finish the bytes queued before us */
+    while (tx_tail != tx_head);
+
+    tx_dma_busy = 1;
+
+    ch->CFGR = 0;
+    DMA1->INTFCR = DMA_GIF(DMA_CH_USART1_TX) | DMA_TCIF(DMA_CH_USART1_TX) |
+                   DMA_HTIF(DMA_CH_USART1_TX) | DMA_TEIF(DMA_CH_USART1_TX);
+    ch->MADDR = (uint32_t)(uintptr_t)buf;
+    ch->CNTR  = len;
+    ch->CFGR  = DMA_CFGR_DIR | DMA_CFGR_MINC | DMA_CFGR_PSIZE_8 |
+                DMA_CFGR_MSIZE_8 | DMA_CFGR_PL_MEDIUM |
+                DMA_CFGR_TCIE | DMA_CFGR_TEIE | DMA_CFGR_EN;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_SendStringDMA
+ *
+ * @brief   Starts a DMA transfer of a null-terminated string.
+ *
+ * @param   s - String to send (must stay valid until the transfer ends)
+ *
+ * @return  uint8_t - 1 if the transfer was started, 0 otherwise
+ *
+ * @note    Best suited to const strings in flash (help text, banners).
+ */
+uint8_t HAL_UART_SendStringDMA(const char *s)
+{
+    uint16_t len = 0;
+    while (s[len])
+        len++;
+
+    return HAL_UART_SendBuffer((const uint8_t *)s, len);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_TxBusy
+ *
+ * @brief   Reports whether a DMA transmit is in progress.
+ *
+ * @return  uint8_t - 1 while DMA owns the transmitter, 0 when idle
+ */
+uint8_t HAL_UART_TxBusy(void)
+{
+    return tx_dma_busy;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_SetTxDoneCallback
+ *
+ * @brief   Registers a function called when a DMA transmit finishes.
+ *
+ * @param   cb - Callback, or NULL to disable
+ *
+ * @return  none
+ *
+ * @note    Runs in interrupt context; keep it short.
+ */
+void HAL_UART_SetTxDoneCallback(UART_TxDoneCallback_t cb)
+{
+    tx_done_cb = cb;
+}
+
+/*********************************************************************
+ * @fn      DMA1_Channel4_IRQHandler
+ *
+ * @brief   DMA1 channel 4 interrupt handler (USART1_TX).
+ *
+ * @return  none
+ *
+ * @note    - Disables the channel, releases the transmitter and hands
+ *            any bytes queued meanwhile to the TXE interrupt.
+ *          - Transfer errors end the transfer the same way.
+ */
+void DMA1_Channel4_IRQHandler(void)
+{
+    IRQ_ENTER();
+
+    uint32_t flags = DMA1->INTFR;
+
+    if (flags & (DMA_TCIF(DMA_CH_USART1_TX) | DMA_TEIF(DMA_CH_USART1_TX)))
+    {
+        DMA1->INTFCR = DMA_GIF(DMA_CH_USART1_TX) | DMA_TCIF(DMA_CH_USART1_TX) |
+                       DMA_HTIF(DMA_CH_USART1_TX) | DMA_TEIF(DMA_CH_USART1_TX);
+        DMA1_CH(DMA_CH_USART1_TX)->CFGR &= ~DMA_CFGR_EN;
+
+        tx_dma_busy = 0;
+
+        if (tx_tail != tx_head)
+            USART1->CTLR1 |= USART_TXEIE;
+
+        if (tx_done_cb)
+            tx_done_cb();
+    }
+
+    IRQ_EXIT(IRQ_DMA1_CH4);
+}
+
+/*********************************************************************
+ * @fn      USART1_IRQHandler
+ *
+ * @brief   USART1 interrupt handler. Stores received bytes, flags the
+ *          idle line and moves the next queued byte into DATAR on TXE.
+ *
+ * @return  none
+ *
+ * @note    - Reading STATR then DATAR clears RXNE, IDLE and ORE.
+ *          - Received bytes that do not fit are counted, not stored.
+ *          - Disables TXEIE once the TX buffer is empty; uart_tx_put()
+ *            re-arms it after queuing new data.
+ */
+void USART1_IRQHandler(void)
+{
+    IRQ_ENTER();
+
+    uint16_t sr = USART1->STATR;
+
+    if (sr & (USART_RXNE | USART_IDLE | USART_ORE))
+    {
+        char c = (char)USART1->DATAR;
+
+        if (sr & USART_ORE)
+            rx_dropped++;
+
+        if (sr & USART_RXNE)
+        {
+            if ((uint16_t)(rx_head - rx_tail) < UART_RX_BUF_SIZE)
+            {
+                rx_buf[rx_head & RX_MASK] = c;
+                rx_head++;
+            }
+            else
+                rx_dropped++;
+        }
+
+        if (sr & USART_IDLE)
+            rx_idle = 1;
+
+        if (rx_cb)
+            rx_cb();
+    }
+
+    if ((USART1->CTLR1 & USART_TXEIE) && (sr & USART_TXE))
+    {
+        if (tx_tail != tx_head)
+        {
+            USART1->DATAR = tx_buf[tx_tail & TX_MASK];
+            tx_tail++;
+        }
+
+        if (tx_tail == tx_head)
+            USART1->CTLR1 &= ~USART_TXEIE;
+    }
+
+    IRQ_EXIT(IRQ_USART1);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_TryReadLine
+ *
+ * @brief   Collects received characters into a line without blocking.
  *
  * @param   buf    - Buffer to store received string
  * @param   maxLen - Maximum buffer length (including null terminator)
  *
- * @return  none
+ * @return  uint8_t - UART_LINE_READY when ENTER completed a line in buf,
+ *                    UART_LINE_BREAK on Ctrl-C (buf is empty),
+ *                    UART_LINE_NONE (0) otherwise
  *
- * @note    - Echoes typed characters back to terminal.
+ * @note    - Call repeatedly from the super-loop with the same buffer;
+ *            the partial line is kept between calls.
+ *          - Ctrl-C discards the partial line; the caller uses it to
+ *            interrupt background work.
+ *          - Echoes typed characters back to terminal.
  *          - Supports Backspace for editing.
- *          - Terminates input on '\r' or '\n'.
+ *          - Terminates input on '\r' or '\n' ("\r\n" counts once).
  *          - Ensures null-terminated string.
- *          - Blocking function.
  */
-void HAL_UART_ReadLine(char *buf, uint8_t maxLen)
+uint8_t HAL_UART_TryReadLine(char *buf, uint8_t maxLen)
 {
-    uint8_t i = 0;
     char c;
 
-    while (1)
+    while (HAL_UART_TryReadChar(&c))
     {
-        c = HAL_UART_ReadChar();
+        char prev = rx_last;
+        rx_last = c;
 
         /* ENTER pressed */
         if (c == '\r' || c == '\n')
         {
+            if (c == '\n' && prev == '\r')
+                continue;
+
             HAL_UART_SendString("\r\n");
-            buf[i] = '\0';
-            return;
+            buf[rx_line_len] = '\0';
+            rx_line_len = 0;
+            return UART_LINE_READY;
+        }
+
+        /* Ctrl-C */
+        if (c == 0x03)
+        {
+            HAL_UART_SendString("^C\r\n");
+            buf[0] = '\0';
+            rx_line_len = 0;
+            return UART_LINE_BREAK;
         }
 
         /* Backspace */
         if (c == 8 || c == 127)
         {
-            if (i > 0)
+            if (rx_line_len > 0)
             {
-                i--;
+                rx_line_len--;
                 HAL_UART_SendString("\b \b"); // erase char on terminal
             }
             continue;
         }
 
         /* Normal character */
-        if (i < maxLen - 1)
+        if (rx_line_len < maxLen - 1)
         {
-            buf[i++] = c;
+            buf[rx_line_len++] = c;
             HAL_UART_SendChar(c); // echo
         }
     }
+
+    return UART_LINE_NONE;
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_ReadLine
+ *
+ * @brief   Reads a line of text from USART1 until ENTER is pressed.
+ *
+ * @param   buf    - Buffer to store received string
+ * @param   maxLen - Maximum buffer length (including null terminator)
+ *
+ * @return  none
+ *
+ * @note    - Blocking wrapper around HAL_UART_TryReadLine().
+ *          - Prefer HAL_UART_TryReadLine() in the super-loop.
+ */
+void HAL_UART_ReadLine(char *buf, uint8_t maxLen)
+{
+    while (!HAL_UART_TryReadLine(buf, maxLen));
+}
+
+
+/*
+ * Number formatting without division. RV32EC has no divide instruction,
+ * so "% 10" and "/ 10" become libgcc calls costing hundreds of cycles per
+ * digit. Decimal digits are produced by repeated subtraction of powers of
+ * ten (at most 9 per digit) and hex digits by shifting out nibbles.
+ */
+static const uint32_t pow10_tab[10] =
+{
+    1000000000U, 100000000U, 10000000U, 1000000U, 100000U,
+    10000U, 1000U, 100U, 10U, 1U
+};
+
+/* Decimal digits of val into out (no leading zeros), returns length */
+static uint8_t fmt_dec(char *out, uint32_t val)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        uint32_t p = pow10_tab[i];
+        char d = '0';
+
+        while (val >= p)
+        {
+            val -= p;
+            d++;
+        }
+
+        if (n || d != '0' || i == 9)
+            out[n++] = d;
+    }
+
+    return n;
+}
+
+/* Internal uart_put_num() flag: lower-case hex digits (%x) */
+#define UART_FMT_LOWER      0x80
+
+/* Hex digits of val into out (no leading zeros), returns length */
+static uint8_t fmt_hex(char *out, uint32_t val, char alpha)
+{
+    uint8_t n = 0;
+
+    for (int8_t sh = 28; sh >= 0; sh -= 4)
+    {
+        uint8_t d = (val >> sh) & 0xF;
+
+        if (n || d || sh == 0)
+            out[n++] = (d < 10) ? ('0' + d) : (alpha + d - 10);
+    }
+
+    return n;
 }
 
+/*
+ * Emit a formatted number: optional sign, padding to width, and a
+ * decimal point before the last 'decimals' digits (fixed-point).
+ */
+static void uart_put_num(uint32_t mag, uint8_t neg, uint8_t base,
+                         uint8_t width, uint8_t flags, uint8_t decimals)
+{
+    char digits[12];
+    char alpha = (flags & UART_FMT_LOWER) ? 'a' : 'A';
+    uint8_t n = (base == 16) ? fmt_hex(digits, mag, alpha) : fmt_dec(digits, mag);
+
+    /* Fixed-point needs at least one digit before the point: 5 → "0.05" */
+    uint8_t lead = (decimals >= n) ? (decimals + 1 - n) : 0;
+    uint8_t len = neg + lead + n + (decimals ? 1 : 0);
+    uint8_t pad = (width > len) ? (width - len) : 0;
+
+    if (!(flags & UART_FMT_ZERO))
+        while (pad--)
+            HAL_UART_SendChar(' ');
+
+    if (neg)
+        HAL_UART_SendChar('-');
+
+    if (flags & UART_FMT_ZERO)
+        while (pad--)
+            HAL_UART_SendChar('0');
+
+    /* Zero-extended digits with the point before the last 'decimals' */
+    uint8_t total = lead + n;
+    uint8_t point = total - decimals;
+
+    for (uint8_t i = 0; i < total; i++)
+    {
+        if (decimals && i == point)
+            HAL_UART_SendChar('.');
+        HAL_UART_SendChar((i < lead) ? '0' : digits[i - lead]);
+    }
+}
 
 /*********************************************************************
  * @fn      HAL_UART_Print
@@ -152,13 +725,13 @@ void HAL_UART_ReadLine(char *buf, uint8_t maxLen)
  *
  * @note    - Only supports base 10 and 16.
  *          - For decimal, prints negative sign if value < 0.
- *          - Uses internal buffer to convert number to string.
+ *          - For hex, negative values print as 32-bit two's complement.
+ *          - Division-free (see fmt_dec()/fmt_hex()).
  */
 void HAL_UART_Print(const char *str, int32_t val, uint8_t base)
 {
     /* Print string */
-    while (*str)
-        HAL_UART_SendChar(*str++);
+    HAL_UART_SendString(str);
 
     /* String-only mode */
     if (val == UART_NO_NUMBER)
@@ -167,33 +740,173 @@ void HAL_UART_Print(const char *str, int32_t val, uint8_t base)
     if (base != 10 && base != 16)
         return;
 
-    /* Zero */
-    if (val == 0)
-    {
-        HAL_UART_SendChar('0');
-        return;
-    }
+    HAL_UART_PrintNum(val, base, 0, 0);
+}
 
-    /* Negative decimal */
-    if (val < 0 && base == 10)
-    {
-        HAL_UART_SendChar('-');
-        val = -val;
-    }
+/*********************************************************************
+ * @fn      HAL_UART_PrintNum
+ *
+ * @brief   Sends a number with optional fixed width and zero padding.
+ *
+ * @param   val   - Value to print
+ * @param   base  - Numerical base (10 = decimal, 16 = hex)
+ * @param   width - Minimum field width (0 = no padding)
+ * @param   flags - UART_FMT_ZERO (pad with '0'), UART_FMT_UNSIGNED
+ *
+ * @return  none
+ *
+ * @note    - Hex is always unsigned.
+ *          - Example: HAL_UART_PrintNum(42, 10, 5, UART_FMT_ZERO) → "00042"
+ */
+void HAL_UART_PrintNum(int32_t val, uint8_t base, uint8_t width, uint8_t flags)
+{
+    uint8_t neg = (base == 10) && !(flags & UART_FMT_UNSIGNED) && (val < 0);
+    uint32_t mag = neg ? (0U - (uint32_t)val) : (uint32_t)val;
+
+    uart_put_num(mag, neg, base, width, flags, 0);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_PrintFixed
+ *
+ * @brief   Sends a scaled integer as a fixed-point decimal number.
+ *
+ * @param   val      - Value scaled by 10^decimals
+ * @param   decimals - Digits after the decimal point (0-9)
+ * @param   width    - Minimum field width (0 = no padding)
+ *
+ * @return  none
+ *
+ * @note    - No division: the point is inserted into the digit string.
+ *          - Example: HAL_UART_PrintFixed(500, 1, 0) → "50.0"
+ *                     HAL_UART_PrintFixed(-5, 2, 0)  → "-0.05"
+ */
+void HAL_UART_PrintFixed(int32_t val, uint8_t decimals, uint8_t width)
+{
+    uint8_t neg = (val < 0);
+    uint32_t mag = neg ? (0U - (uint32_t)val) : (uint32_t)val;
+
+    if (decimals > 9)
+        decimals = 9;
+
+    uart_put_num(mag, neg, 10, width, 0, decimals);
+}
+
+/*********************************************************************
+ * @fn      HAL_UART_Printf
+ *
+ * @brief   Minimal printf that formats straight into the UART TX path.
+ *
+ * @param   fmt - Format string, followed by the arguments
+ *
+ * @return  none
+ *
+ * @note    - Conversions: %d %u %x %X %s %c %%, optional 'l' modifier.
+ *          - Flags/width: '0' for zero padding, decimal field width
+ *            (e.g. "%5d", "%04x", "%8s").
+ *          - No heap and no line buffer: characters go to
+ *            HAL_UART_SendChar() as they are produced; the only buffer
+ *            is the 12-byte digit array in uart_put_num().
+ *          - Division- and multiply-free, like HAL_UART_PrintNum().
+ *          - Arguments are checked by GCC (format attribute).
+ */
+void HAL_UART_Printf(const char *fmt, ...)
+{
+    va_list ap;
 
-    char buf[16];
-    uint8_t i = 0;
+    va_start(ap, fmt);
 
-    /* Convert number to string */
-    while (val)
+    while (*fmt)
     {
-        uint8_t d = val % base;
-        buf[i++] = (d < 10) ? ('0' + d) : ('A' + d - 10);
-        val /= base;
+        char c = *fmt++;
+
+        if (c != '%')
+        {
+            HAL_UART_SendChar(c);
+            continue;
+        }
+
+        uint8_t flags = 0;
+        uint8_t width = 0;
+        uint8_t is_long = 0;
+
+        if (*fmt == '0')
+        {
+            flags |= UART_FMT_ZERO;
+            fmt++;
+        }
+
+        /* width * 10 as shifts: RV32EC has no multiply either */
+        while (*fmt >= '0' && *fmt <= '9')
+            width = (width << 3) + (width << 1) + (*fmt++ - '0');
+
+        if (*fmt == 'l')
+        {
+            is_long = 1;
+            fmt++;
+        }
+
+        switch (*fmt)
+        {
+            case 'd':
+            {
+                int32_t v = is_long ? (int32_t)va_arg(ap, long) : va_arg(ap, int);
+                uint8_t neg = (v < 0);
+                uart_put_num(neg ? (0U - (uint32_t)v) : (uint32_t)v, neg, 10, width, flags, 0);
+                break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            {
+                uint32_t v = is_long ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+
+                if (*fmt == 'x')
+                    flags |= UART_FMT_LOWER;
+
+                uart_put_num(v, 0, (*fmt == 'u') ? 10 : 16, width, flags, 0);
+                break;
+            }
+
+            case 's':
+            {
+                const char *str = va_arg(ap, const char *);
+                uint8_t len = 0;
+
+                while (str[len] && len < 255)
+                    len++;
+
+                while (width-- > len)
+                    HAL_UART_SendChar(' ');
+
+                while (*str)
+                    HAL_UART_SendChar(*str++);
+                break;
+            }
+
+            case 'c':
+                HAL_UART_SendChar((char)va_arg(ap, int));
+                break;
+
+            case '%':
+                HAL_UART_SendChar('%');
+                break;
+
+            case '\0':
+                /* Lone '%' at the end of the string */
+                va_end(ap);
+                return;
+
+            default:
+                /* Unknown conversion: print it as-is */
+                HAL_UART_SendChar('%');
+                HAL_UART_SendChar(*fmt);
+                break;
+        }
+
+        fmt++;
     }
 
-    /* Send number string in correct order */
-    while (i--)
-        HAL_UART_SendChar(buf[i]);
+    va_end(ap);
 }
-
@@ -0,0 +1,238 @@
+#include "jobs.h"
+#include "cli.h"
+
+static JOB_t job_pool[JOB_MAX];
+static uint8_t job_next_id = 1;
+
+/* Free a running job's slot, then let it release its hardware */
+static void job_kill(JOB_t *j)
+{
+    JOB_KillHook_t hook = j->on_kill;
+
+    j->id = 0;
+
+    if (hook)
+        hook(j);
+}
+
+/*********************************************************************
+ * @fn      JOB_Start
+ *
+ * @brief   Starts a cooperative background job.
+ *
+ * @param   name      - Name shown by 'jobs'
+ * @param   step      - Step function, called every period_ms
+ * @param   period_ms - Time between steps (0 = every JOB_Poll())
+ * @param   d0, d1    - Initial job-private data
+ *
+ * @return  uint8_t - Job id (1-255), or 0 if all JOB_MAX slots are busy
+ *
+ * @note    - The first step runs one period after the start.
+ *          - Protothread steps normally use period 0 and wait with
+ *            PT_DELAY_MS() instead.
+ */
+uint8_t JOB_Start(const char *name, JOB_Step_t step, uint32_t period_ms,
+                  int32_t d0, int32_t d1)
+{
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        JOB_t *j = &job_pool[i];
+
+        if (j->id)
+            continue;
+
+        j->name = name;
+        j->step = step;
+        j->on_kill = NULL;
+        j->period_ms = period_ms;
+        j->next_ms = HAL_GetTick() + period_ms;
+        j->data[0] = d0;
+        j->data[1] = d1;
+        PT_INIT(&j->pt);
+
+        j->id = job_next_id++;
+        if (job_next_id == 0)
+            job_next_id = 1;
+
+        return j->id;
+    }
+
+    return 0;
+}
+
+/*********************************************************************
+ * @fn      JOB_SetKillHook
+ *
+ * @brief   Installs a function that runs when the job is killed.
+ *
+ * @param   id   - Job id returned by JOB_Start()
+ * @param   hook - Cleanup function, or NULL to remove it
+ *
+ * @return  uint8_t - 1 if the job is running, 0 otherwise
+ *
+ * @note    - Runs from JOB_Kill()/JOB_KillAll() (kill command, Ctrl-C)
+ *            after the slot is freed, not when the step returns 0.
+ *          - Use it to stop timers or DMA channels the job drives.
+ */
+uint8_t JOB_SetKillHook(uint8_t id, JOB_KillHook_t hook)
+{
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        if (id && job_pool[i].id == id)
+        {
+            job_pool[i].on_kill = hook;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*********************************************************************
+ * @fn      JOB_Kill
+ *
+ * @brief   Stops the job with the given id.
+ *
+ * @param   id - Job id returned by JOB_Start()
+ *
+ * @return  uint8_t - 1 if the job was running, 0 otherwise
+ */
+uint8_t JOB_Kill(uint8_t id)
+{
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        if (id && job_pool[i].id == id)
+        {
+            job_kill(&job_pool[i]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*********************************************************************
+ * @fn      JOB_KillAll
+ *
+ * @brief   Stops every running job.
+ *
+ * @return  none
+ *
+ * @note    Kill hooks run, so Ctrl-C also stops the hardware jobs use.
+ */
+void JOB_KillAll(void)
+{
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+        if (job_pool[i].id)
+            job_kill(&job_pool[i]);
+}
+
+/*********************************************************************
+ * @fn      JOB_Running
+ *
+ * @brief   Checks whether the job with the given id is still running.
+ *
+ * @param   id - Job id returned by JOB_Start()
+ *
+ * @return  uint8_t - 1 if running, 0 if finished, killed or id is 0
+ */
+uint8_t JOB_Running(uint8_t id)
+{
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+        if (id && job_pool[i].id == id)
+            return 1;
+
+    return 0;
+}
+
+/*********************************************************************
+ * @fn      JOB_Poll
+ *
+ * @brief   Runs one step of every job whose time has come.
+ *
+ * @return  none
+ *
+ * @note    - Call from the super-loop; steps must return quickly.
+ *          - Wrap-safe: compares (now - next) as signed.
+ *          - Late steps are not replayed; the next one is scheduled a
+ *            full period from the previous due time.
+ */
+void JOB_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        JOB_t *j = &job_pool[i];
+
+        if (!j->id || (int32_t)(now - j->next_ms) < 0)
+            continue;
+
+        j->next_ms += j->period_ms;
+        if ((int32_t)(now - j->next_ms) >= 0)
+            j->next_ms = now + j->period_ms;
+
+        if (!j->step(j))
+        {
+            HAL_UART_Printf("[%u] %s done\r\n", j->id, j->name);
+            j->id = 0;
+        }
+    }
+}
+
+
+/* ---- JOBS ---- */
+static void cmd_jobs(uint8_t argc, char *argv[])
+{
+    uint8_t any = 0;
+
+    for (uint8_t i = 0; i < JOB_MAX; i++)
+    {
+        JOB_t *j = &job_pool[i];
+
+        if (!j->id)
+            continue;
+
+        HAL_UART_Printf("[%u] %s every %lu ms\r\n", j->id, j->name,
+                        (unsigned long)j->period_ms);
+        any = 1;
+    }
+
+    if (!any)
+        HAL_UART_SendString("No jobs\r\n");
+}
+
+/* ---- KILL ---- */
+static void cmd_kill(uint8_t argc, char *argv[])
+{
+    int32_t id;
+
+    if (!CLI_ArgInt("id", argv[1], 1, 255, &id))
+        return;
+
+    if (JOB_Kill(id))
+        HAL_UART_Printf("[%ld] killed\r\n", (long)id);
+    else
+        HAL_UART_SendString("Error: no such job\r\n");
+}
+
+static const CLI_Command_t job_cmds[] =
+{
+    { "jobs", "",     0, 0, cmd_jobs, "List background jobs" },
+    { "kill", "<id>", 1, 1, cmd_kill, "Stop a background job (Ctrl-C stops all)" },
+};
+
+/*********************************************************************
+ * @fn      JOB_Init
+ *
+ * @brief   Clears the job pool and registers the job commands.
+ *
+ * @return  none
+ *
+ * @note    Call after CLI_Init(). Job timing uses HAL_GetTick().
+ */
+void JOB_Init(void)
+{
+    JOB_KillAll();
+    CLI_Register(job_cmds, sizeof(job_cmds) / sizeof(job_cmds[0]));
+}
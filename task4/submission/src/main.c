@@ -2,30 +2,119 @@
 #include "driver_gpio.h"
 #include "driver_usart_debug.h"
 #include "cli.h"
+#include "board.h"
+#include "jobs.h"
+#include "capture.h"
+#include "swtimer.h"
+#include "sched.h"
+#include "critical.h"
 
 /* LED CONFIG */
 #define LED_PORT   GPIOD
 #define LED_PIN    4
 
-int main(void)
+/* Scheduler tasks (priority 0 = highest) */
+#define PRIO_TIMERS     0
+#define PRIO_CONSOLE    1
+#define PRIO_JOBS       2
+
+/* Events */
+#define EV_RX           0x0001      // console: UART data arrived
+#define EV_TIMER        0x0001      // timers: deferred callbacks queued
+#define EV_TICK         0x0001      // jobs: 1 ms tick
+
+static SCHED_Task_t task_timers;
+static SCHED_Task_t task_console;
+static SCHED_Task_t task_jobs;
+
+static char cmd_buffer[64];
+
+/* Interrupt-side event sources */
+static void on_uart_rx(void)
+{
+    SCHED_Post(task_console, EV_RX);
+}
+
+static void on_timer(void)
+{
+    SCHED_Post(task_timers, EV_TIMER);
+}
+
+static void on_tick(void)
+{
+    SCHED_Post(task_jobs, EV_TICK);
+}
+
+/* Console: handle every complete line in the RX buffer */
+static void console_task(uint16_t events)
+{
+    uint8_t line;
+
+    while ((line = HAL_UART_TryReadLine(cmd_buffer, sizeof(cmd_buffer))) != UART_LINE_NONE)
+    {
+        if (line == UART_LINE_BREAK)
+        {
+            /* Ctrl-C ends a pending line read and stops all background jobs */
+            CLI_Break();
+            JOB_KillAll();
+        }
+        else
+        {
+            CLI_Process(cmd_buffer);
+        }
+
+        HAL_UART_SendString("> ");
+    }
+}
+
+/* Deferred software timer callbacks */
+static void timers_task(uint16_t events)
 {
-    char cmd_buffer[64];
+    SWTIMER_Poll();
+}
 
+/* Background jobs (blink, capture, ...) */
+static void jobs_task(uint16_t events)
+{
+    JOB_Poll();
+}
+
+int main(void)
+{
     /* Init system */
     SystemInit();
 
+    /* Interrupt controller: hardware register save, two nesting levels.
+       RX must not be lost behind long tick hooks, so USART1 preempts;
+       the two hottest handlers skip the vector table fetch. */
+    HAL_PFIC_Config(PFIC_HPE | PFIC_NEST);
+    HAL_PFIC_SetPriority(IRQ_USART1, PFIC_PRIO_HIGHEST);
+    HAL_PFIC_SetPriority(IRQ_SYSTICK, 2);
+    HAL_PFIC_SetVTF(0, IRQ_SYSTICK, SysTick_Handler);
+    HAL_PFIC_SetVTF(1, IRQ_USART1, USART1_IRQHandler);
+
     // Initialize Delay 
     HAL_Delay_Init();
 
+    // Software timers on the SysTick
+    SWTIMER_Init();
+
     // Initialize UART Prints
     HAL_UART_Init();
 
-    // Enable GPIOD clock using RCC driver
-    HAL_RCC_APB2_Enable(RCC_GPIOD);
+    /* Board pins (clocks + configuration) from the pin map */
+    HAL_GPIO_InitTable(board_pins, board_pin_count);
 
+    /* Register CLI commands */
+    CLI_Init();
+    JOB_Init();
+    CAPTURE_Init();
+    SCHED_Init();
+    IRQSTAT_Init();
 
-    /* GPIO configuration moved here */
-    HAL_GPIO_Init(LED_PORT, LED_PIN, GPIO_MODE_OUTPUT_50MHz, GPIO_CNF_PUSH_PULL);
+    task_timers  = SCHED_TaskCreate("timers",  timers_task,  PRIO_TIMERS);
+    task_console = SCHED_TaskCreate("console", console_task, PRIO_CONSOLE);
+    task_jobs    = SCHED_TaskCreate("jobs",    jobs_task,    PRIO_JOBS);
 
     /* Startup banner */
     HAL_UART_SendString("\r\n==============================\r\n");
@@ -33,11 +122,16 @@ int main(void)
     HAL_UART_SendString(" Type 'help' for commands\r\n");
     HAL_UART_SendString("==============================\r\n");
 
-    while (1)
-    {
-        HAL_UART_SendString("> ");
-        HAL_UART_ReadLine(cmd_buffer, sizeof(cmd_buffer));
-        CLI_Process(cmd_buffer);
-    }
+    HAL_UART_SendString("> ");
+
+    /* Event sources → tasks; from here on everything is event driven */
+    HAL_UART_SetRxCallback(on_uart_rx);
+    SWTIMER_SetNotify(on_timer);
+    HAL_Tick_AddHook(on_tick);
+
+    /* Pick up anything typed during start-up */
+    SCHED_Post(task_console, EV_RX);
+
+    SCHED_Run();
     return 0;
 }
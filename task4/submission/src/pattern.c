@@ -0,0 +1,186 @@
+#include "pattern.h"
+#include "critical.h"
+
+/*
+ * Pattern generator: TIM1 update events request DMA1 channel 5, which
+ * writes the next 32-bit word of a table into GPIOx->BSHR. The low
+ * half of a word sets pins and the high half clears them, so each step
+ * drives exactly the pins of the pattern and leaves the rest of the
+ * port alone. The CPU is not involved while the pattern plays.
+ */
+static volatile uint8_t pat_active;
+static PATTERN_DoneCallback_t pat_done_cb;
+
+/*********************************************************************
+ * @fn      PATTERN_Build
+ *
+ * @brief   Converts per-pin bit streams into a table of BSHR words.
+ *
+ * @param   words   - Output table, one word per step
+ * @param   steps   - Number of steps
+ * @param   streams - Pins and their bit streams (steps bits each)
+ * @param   count   - Number of streams
+ *
+ * @return  none
+ *
+ * @note    - Step n of a stream is bit (n & 7) of byte (n >> 3).
+ *          - A 1 sets the pin (BSy), a 0 clears it (BRy); pins without
+ *            a stream are never written.
+ *          - Tables may also be precomputed as const arrays in flash;
+ *            the DMA reads them from there directly.
+ */
+void PATTERN_Build(uint32_t *words, uint16_t steps,
+                   const PATTERN_Stream_t *streams, uint8_t count)
+{
+    for (uint16_t n = 0; n < steps; n++)
+    {
+        uint32_t w = 0;
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint8_t pin = streams[i].pin;
+
+            if ((streams[i].bits[n >> 3] >> (n & 7)) & 1)
+                w |= (1U << pin);
+            else
+                w |= (1U << (pin + 16));
+        }
+
+        words[n] = w;
+    }
+}
+
+/*********************************************************************
+ * @fn      PATTERN_Start
+ *
+ * @brief   Starts replaying a BSHR word table on a GPIO port.
+ *
+ * @param   port    - GPIOA, GPIOC or GPIOD (pins configured as outputs)
+ * @param   words   - Table from PATTERN_Build() (RAM or flash)
+ * @param   steps   - Number of words (1-65535)
+ * @param   rate_hz - Steps per second
+ * @param   mode    - PATTERN_ONESHOT or PATTERN_CIRCULAR
+ *
+ * @return  uint8_t - 1 if started, 0 if a pattern is playing or the
+ *                    arguments are invalid
+ *
+ * @note    - The first step is output one period after the start.
+ *          - The table must stay valid until the pattern ends.
+ *          - Uses TIM1 (HAL_TIM_SetUpdateRate) and DMA1 channel 5, so
+ *            it cannot run together with HAL_PWM or a USART1 RX DMA.
+ *          - Each step takes SYSCLK / rate_hz cycles (the timer
+ *            period), and the DMA beat must fit inside it: one table
+ *            read, one BSHR write and channel arbitration, a few bus
+ *            cycles (not measured). A request that arrives before the
+ *            last beat has finished is lost and that step is skipped.
+ *            Keep at least 10 SYSCLK cycles per step: rate_hz up to
+ *            2.4 MHz at the 24 MHz SYSCLK, less while other DMA
+ *            channels are busy.
+ */
+uint8_t PATTERN_Start(GPIO_RegDef_t *port, const uint32_t *words,
+                      uint16_t steps, uint32_t rate_hz, PATTERN_Mode_t mode)
+{
+    DMA_Channel_RegDef_t *ch = DMA1_CH(DMA_CH_TIM1_UP);
+
+    if (pat_active || steps == 0 || rate_hz == 0)
+        return 0;
+
+    RCC->AHBPCENR |= RCC_DMA1EN;
+    RCC->APB2PCENR |= RCC_TIM1EN;
+
+    /* Timer base; UG loads PSC before the DMA request is enabled */
+    TIM1->CTLR1 = 0;
+    HAL_TIM_SetUpdateRate(TIM1, rate_hz);
+
+    /* Table word → BSHR */
+    ch->CFGR  = 0;
+    ch->PADDR = (uint32_t)(uintptr_t)&port->BSHR;
+    ch->MADDR = (uint32_t)(uintptr_t)words;
+    ch->CNTR  = steps;
+    DMA1->INTFCR = DMA_GIF(DMA_CH_TIM1_UP) | DMA_HTIF(DMA_CH_TIM1_UP) |
+                   DMA_TCIF(DMA_CH_TIM1_UP) | DMA_TEIF(DMA_CH_TIM1_UP);
+
+    ch->CFGR = DMA_CFGR_DIR | DMA_CFGR_MINC | DMA_CFGR_PSIZE_32 |
+               DMA_CFGR_MSIZE_32 | DMA_CFGR_PL_VHIGH |
+               (mode == PATTERN_CIRCULAR ? DMA_CFGR_CIRC : DMA_CFGR_TCIE);
+    ch->CFGR |= DMA_CFGR_EN;
+
+    HAL_PFIC_EnableIRQ(IRQ_DMA1_CH5);
+
+    pat_active = 1;
+    TIM1->DMAINTENR = TIM_DMAINTENR_UDE;
+    TIM1->CTLR1 = TIM_CTLR1_CEN;
+
+    return 1;
+}
+
+/*********************************************************************
+ * @fn      PATTERN_Stop
+ *
+ * @brief   Stops the pattern output.
+ *
+ * @return  none
+ *
+ * @note    Pins keep the level of the last step written.
+ */
+void PATTERN_Stop(void)
+{
+    TIM1->CTLR1 &= ~TIM_CTLR1_CEN;
+    TIM1->DMAINTENR &= ~TIM_DMAINTENR_UDE;
+    DMA1_CH(DMA_CH_TIM1_UP)->CFGR &= ~DMA_CFGR_EN;
+    pat_active = 0;
+}
+
+/*********************************************************************
+ * @fn      PATTERN_Busy
+ *
+ * @brief   Checks whether a pattern is playing.
+ *
+ * @return  uint8_t - 1 while output is running
+ */
+uint8_t PATTERN_Busy(void)
+{
+    return pat_active;
+}
+
+/*********************************************************************
+ * @fn      PATTERN_SetDoneCallback
+ *
+ * @brief   Sets the function called when a one-shot pattern ends.
+ *
+ * @param   cb - Callback (interrupt context) or NULL
+ *
+ * @return  none
+ */
+void PATTERN_SetDoneCallback(PATTERN_DoneCallback_t cb)
+{
+    pat_done_cb = cb;
+}
+
+/*********************************************************************
+ * @fn      DMA1_Channel5_IRQHandler
+ *
+ * @brief   Ends a one-shot pattern after its last word.
+ *
+ * @return  none
+ *
+ * @note    Only enabled (TCIE) in one-shot mode.
+ */
+void DMA1_Channel5_IRQHandler(void)
+{
+    IRQ_ENTER();
+
+    uint32_t flags = DMA1->INTFR;
+
+    DMA1->INTFCR = DMA_GIF(DMA_CH_TIM1_UP) | DMA_TCIF(DMA_CH_TIM1_UP);
+
+    if (flags & DMA_TCIF(DMA_CH_TIM1_UP))
+    {
+        PATTERN_Stop();
+
+        if (pat_done_cb)
+            pat_done_cb();
+    }
+
+    IRQ_EXIT(IRQ_DMA1_CH5);
+}
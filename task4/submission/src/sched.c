@@ -0,0 +1,225 @@
+#include "sched.h"
+#include "cli.h"
+#include "critical.h"
+
+/*
+ * Run-to-completion scheduler. Each task has a set of pending event
+ * bits; posting events makes the task ready and appends it to the FIFO
+ * of its priority level (once, however many events arrive). SCHED_Run
+ * always takes the first task of the highest non-empty level, hands it
+ * the events collected so far and waits for it to return. Tasks never
+ * block, so one stack is enough.
+ */
+typedef struct
+{
+    const char       *name;
+    SCHED_Handler_t   fn;
+    volatile uint16_t events;
+    uint8_t           prio;
+    uint8_t           queued;
+    SCHED_Stats_t     stats;
+} SCHED_TCB_t;
+
+static SCHED_TCB_t sched_tasks[SCHED_MAX_TASKS];
+static uint8_t sched_num_tasks;
+
+/* Ready FIFO per priority: circular list of task ids */
+static uint8_t sched_ready[SCHED_PRIOS][SCHED_MAX_TASKS];
+static uint8_t sched_head[SCHED_PRIOS];
+static uint8_t sched_count[SCHED_PRIOS];
+
+/*********************************************************************
+ * @fn      SCHED_TaskCreate
+ *
+ * @brief   Adds a task to the scheduler.
+ *
+ * @param   name - Name shown by 'tasks'
+ * @param   fn   - Handler, called with the pending event bits
+ * @param   prio - Priority, 0 (highest) to SCHED_PRIOS-1
+ *
+ * @return  SCHED_Task_t - Task id, SCHED_NONE if the table is full
+ *
+ * @note    Tasks are created at start-up and never deleted.
+ */
+SCHED_Task_t SCHED_TaskCreate(const char *name, SCHED_Handler_t fn, uint8_t prio)
+{
+    if (sched_num_tasks == SCHED_MAX_TASKS || fn == NULL)
+        return SCHED_NONE;
+
+    if (prio >= SCHED_PRIOS)
+        prio = SCHED_PRIOS - 1;
+
+    SCHED_TCB_t *t = &sched_tasks[sched_num_tasks];
+
+    t->name = name;
+    t->fn = fn;
+    t->events = 0;
+    t->prio = prio;
+    t->queued = 0;
+    t->stats.runs = 0;
+    t->stats.wcet_cycles = 0;
+
+    return sched_num_tasks++;
+}
+
+/*********************************************************************
+ * @fn      SCHED_Post
+ *
+ * @brief   Posts events to a task and makes it ready.
+ *
+ * @param   t      - Task id
+ * @param   events - Event bits (OR-ed with those already pending)
+ *
+ * @return  none
+ *
+ * @note    - Callable from interrupts and tasks.
+ *          - Events are flags: posting the same bit twice before the
+ *            task runs delivers it once.
+ */
+void SCHED_Post(SCHED_Task_t t, uint16_t events)
+{
+    if (t >= sched_num_tasks || events == 0)
+        return;
+
+    SCHED_TCB_t *tcb = &sched_tasks[t];
+    uint32_t irq = CRIT_ENTER();
+
+    tcb->events |= events;
+
+    if (!tcb->queued)
+    {
+        uint8_t p = tcb->prio;
+        uint8_t tail = sched_head[p] + sched_count[p];
+
+        if (tail >= SCHED_MAX_TASKS)
+            tail -= SCHED_MAX_TASKS;
+
+        sched_ready[p][tail] = t;
+        sched_count[p]++;
+        tcb->queued = 1;
+    }
+
+    CRIT_EXIT(irq);
+}
+
+/*********************************************************************
+ * @fn      SCHED_Run
+ *
+ * @brief   Scheduler main loop; replaces the super-loop in main().
+ *
+ * @return  never
+ *
+ * @note    - Runs the first ready task of the highest priority, then
+ *            looks again, so a higher-priority event is served as
+ *            soon as the current task returns.
+ *          - Tasks of equal priority run in the order they were made
+ *            ready.
+ *          - Sleeps with WFI when nothing is ready. Interrupts are
+ *            masked across the check and the WFI so an event posted in
+ *            between cannot be missed; a pending interrupt still wakes
+ *            the core and is taken when they are unmasked.
+ *          - Counts runs and the longest run per task, in raw HCLK
+ *            cycles (HAL_GetCycles: no divide on the dispatch path).
+ *          - Uses the untimed crit_enter()/crit_exit() so sleeping in
+ *            WFI does not show up as the longest masked span.
+ */
+void SCHED_Run(void)
+{
+    for (;;)
+    {
+        uint32_t irq = crit_enter();
+        uint8_t p;
+
+        for (p = 0; p < SCHED_PRIOS; p++)
+            if (sched_count[p])
+                break;
+
+        if (p == SCHED_PRIOS)
+        {
+#if defined(__riscv)
+            __asm volatile ("wfi");
+#endif
+            crit_exit(irq);
+            continue;
+        }
+
+        SCHED_Task_t id = sched_ready[p][sched_head[p]];
+        SCHED_TCB_t *t = &sched_tasks[id];
+
+        if (++sched_head[p] == SCHED_MAX_TASKS)
+            sched_head[p] = 0;
+        sched_count[p]--;
+
+        uint16_t events = t->events;
+        t->events = 0;
+        t->queued = 0;
+
+        crit_exit(irq);
+
+        uint32_t start = HAL_GetCycles();
+        t->fn(events);
+        uint32_t took = HAL_GetCycles() - start;
+
+        t->stats.runs++;
+        if (took > t->stats.wcet_cycles)
+            t->stats.wcet_cycles = took;
+    }
+}
+
+/*********************************************************************
+ * @fn      SCHED_GetStats
+ *
+ * @brief   Returns the run statistics of a task.
+ *
+ * @param   t - Task id
+ *
+ * @return  const SCHED_Stats_t* - Statistics, NULL for an invalid id
+ */
+const SCHED_Stats_t *SCHED_GetStats(SCHED_Task_t t)
+{
+    return (t < sched_num_tasks) ? &sched_tasks[t].stats : NULL;
+}
+
+
+/* ---- TASKS ---- */
+static void cmd_tasks(uint8_t argc, char *argv[])
+{
+    HAL_UART_SendString("id prio       runs  wcet(us) name\r\n");
+
+    for (uint8_t i = 0; i < sched_num_tasks; i++)
+    {
+        SCHED_TCB_t *t = &sched_tasks[i];
+
+        HAL_UART_Printf("%2u %4u %10lu %9lu %s\r\n", i, t->prio,
+                        (unsigned long)t->stats.runs,
+                        (unsigned long)HAL_CyclesToMicros(t->stats.wcet_cycles),
+                        t->name);
+    }
+}
+
+static const CLI_Command_t sched_cmds[] =
+{
+    { "tasks", "", 0, 0, cmd_tasks, "List scheduler tasks with run counts and WCET" },
+};
+
+/*********************************************************************
+ * @fn      SCHED_Init
+ *
+ * @brief   Clears the task table and registers the 'tasks' command.
+ *
+ * @return  none
+ *
+ * @note    Call after CLI_Init(), before creating tasks.
+ */
+void SCHED_Init(void)
+{
+    sched_num_tasks = 0;
+
+    for (uint8_t p = 0; p < SCHED_PRIOS; p++)
+    {
+        sched_head[p] = 0;
+        sched_count[p] = 0;
+    }
+
+    CLI_Register(sched_cmds, sizeof(sched_cmds) / sizeof(sched_cmds[0]));
+}
@@ -0,0 +1,374 @@
+#include "swtimer.h"
+
+#if SWTIMER_MAX > 254
+#error "SWTIMER_MAX must be at most 254"
+#endif
+
+#define SWT_MASK        (SWTIMER_SLOTS - 1)
+#define SWT_SLOT_NONE   0xFF
+
+/* Timer flags (low bits are the SWTIMER_ create flags) */
+#define SWT_USED        0x10
+#define SWT_PENDING     0x20    // callback due (cleared by Stop)
+#define SWT_QUEUED      0x40    // index sits in swt_queue (cleared by Poll)
+
+/*
+ * Hierarchical timing wheel. Level 0 holds timers due within 32 ms,
+ * one slot per millisecond; level 1 covers 1 s in 32 ms slots and
+ * level 2 covers 32 s in 1 s slots. A timer sits in the slot of its
+ * absolute expiry time at the lowest level that can hold it and moves
+ * down as the wheel turns, so start, stop and expiry are O(1) and each
+ * timer is moved at most twice. Longer delays park in the last level-2
+ * slot and are re-inserted when it comes round.
+ *
+ * Slots are doubly linked lists of pool indices (uint8) to keep a
+ * timer at 16 bytes.
+ */
+typedef struct
+{
+    SWTIMER_Callback_t cb;
+    uint32_t expires;       // swt_now value of the next expiry
+    uint32_t period;        // 0 = one-shot
+    uint8_t  next;
+    uint8_t  prev;
+    uint8_t  slot;          // level * SWTIMER_SLOTS + index, or SWT_SLOT_NONE
+    uint8_t  flags;
+} SWT_Timer_t;
+
+static SWT_Timer_t swt_pool[SWTIMER_MAX];
+static uint8_t swt_wheel[SWTIMER_LEVELS * SWTIMER_SLOTS];
+static uint8_t swt_free;
+static volatile uint32_t swt_now;
+
+/*
+ * Deferred callbacks: SysTick pushes at tail, SWTIMER_Poll pops at head.
+ * A timer occupies at most one entry (SWT_QUEUED), so the queue cannot
+ * overflow; Stop only clears SWT_PENDING and Poll skips the entry.
+ */
+#define SWT_QLEN        (SWTIMER_MAX + 1)
+static volatile uint8_t swt_queue[SWT_QLEN];
+static volatile uint8_t swt_qhead;
+static volatile uint8_t swt_qtail;
+static void (*swt_notify)(void);
+
+/* Keep the SysTick hook out while lists are edited */
+static inline void swt_lock(void)
+{
+    HAL_PFIC_DisableIRQ(IRQ_SYSTICK);
+}
+
+static inline void swt_unlock(void)
+{
+    HAL_PFIC_EnableIRQ(IRQ_SYSTICK);
+}
+
+/* Remove a timer from its slot list */
+static void swt_unlink(uint8_t i)
+{
+    SWT_Timer_t *t = &swt_pool[i];
+
+    if (t->slot == SWT_SLOT_NONE)
+        return;
+
+    if (t->prev != SWTIMER_NONE)
+        swt_pool[t->prev].next = t->next;
+    else
+        swt_wheel[t->slot] = t->next;
+
+    if (t->next != SWTIMER_NONE)
+        swt_pool[t->next].prev = t->prev;
+
+    t->slot = SWT_SLOT_NONE;
+}
+
+/* Put a timer into the slot matching its expiry time */
+static void swt_link(uint8_t i)
+{
+    SWT_Timer_t *t = &swt_pool[i];
+    uint32_t now = swt_now;
+    uint32_t delta = t->expires - now;
+    uint8_t slot;
+
+    if (delta < SWTIMER_SLOTS)
+        slot = t->expires & SWT_MASK;
+    else if (delta < (1UL << (2 * SWTIMER_BITS)))
+        slot = SWTIMER_SLOTS + ((t->expires >> SWTIMER_BITS) & SWT_MASK);
+    else if (delta < (1UL << (3 * SWTIMER_BITS)))
+        slot = 2 * SWTIMER_SLOTS + ((t->expires >> (2 * SWTIMER_BITS)) & SWT_MASK);
+    else
+        slot = 2 * SWTIMER_SLOTS + (((now >> (2 * SWTIMER_BITS)) - 1) & SWT_MASK);
+
+    t->slot = slot;
+    t->prev = SWTIMER_NONE;
+    t->next = swt_wheel[slot];
+
+    if (t->next != SWTIMER_NONE)
+        swt_pool[t->next].prev = i;
+
+    swt_wheel[slot] = i;
+}
+
+/* Move every timer of a higher-level slot down the wheel */
+static void swt_cascade(uint8_t slot)
+{
+    uint8_t i;
+
+    while ((i = swt_wheel[slot]) != SWTIMER_NONE)
+    {
+        swt_unlink(i);
+        swt_link(i);
+    }
+}
+
+/* SysTick hook: advance the wheel by 1 ms and expire the current slot */
+static void swt_tick(void)
+{
+    uint32_t now = ++swt_now;
+    uint8_t i;
+
+    if ((now & SWT_MASK) == 0)
+    {
+        if (((now >> SWTIMER_BITS) & SWT_MASK) == 0)
+            swt_cascade(2 * SWTIMER_SLOTS + ((now >> (2 * SWTIMER_BITS)) & SWT_MASK));
+
+        swt_cascade(SWTIMER_SLOTS + ((now >> SWTIMER_BITS) & SWT_MASK));
+    }
+
+    while ((i = swt_wheel[now & SWT_MASK]) != SWTIMER_NONE)
+    {
+        SWT_Timer_t *t = &swt_pool[i];
+
+        swt_unlink(i);
+
+        /* Re-arm first so the callback may stop or restart the timer */
+        if (t->period)
+        {
+            t->expires += t->period;
+            swt_link(i);
+        }
+
+        if (t->flags & SWTIMER_ISR)
+        {
+            t->cb(i);
+        }
+        else if (!(t->flags & SWT_PENDING))
+        {
+            t->flags |= SWT_PENDING;
+
+            /* Still queued after a Stop/Start: reuse that entry */
+            if (!(t->flags & SWT_QUEUED))
+            {
+                uint8_t tail = swt_qtail;
+
+                t->flags |= SWT_QUEUED;
+                swt_queue[tail] = i;
+                swt_qtail = (tail + 1 == SWT_QLEN) ? 0 : tail + 1;
+            }
+
+            if (swt_notify)
+                swt_notify();
+        }
+    }
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Init
+ *
+ * @brief   Clears the timer pool and hooks the wheel into SysTick.
+ *
+ * @return  none
+ *
+ * @note    Call after HAL_Delay_Init(). Resolution is 1 ms.
+ */
+void SWTIMER_Init(void)
+{
+    for (uint8_t s = 0; s < SWTIMER_LEVELS * SWTIMER_SLOTS; s++)
+        swt_wheel[s] = SWTIMER_NONE;
+
+    for (uint8_t i = 0; i < SWTIMER_MAX; i++)
+    {
+        swt_pool[i].flags = 0;
+        swt_pool[i].slot = SWT_SLOT_NONE;
+        swt_pool[i].next = (i + 1 < SWTIMER_MAX) ? i + 1 : SWTIMER_NONE;
+    }
+
+    swt_free = 0;
+    swt_qhead = swt_qtail = 0;
+
+    HAL_Tick_AddHook(swt_tick);
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Create
+ *
+ * @brief   Takes a timer from the static pool.
+ *
+ * @param   cb    - Expiry callback (must not be NULL)
+ * @param   flags - 0 = callback from SWTIMER_Poll(),
+ *                  SWTIMER_ISR = callback in the SysTick interrupt
+ *
+ * @return  SWTimer_t - Timer handle, SWTIMER_NONE if the pool is empty
+ *
+ * @note    The timer is created stopped.
+ */
+SWTimer_t SWTIMER_Create(SWTIMER_Callback_t cb, uint8_t flags)
+{
+    uint8_t i = swt_free;
+
+    if (i == SWTIMER_NONE || cb == NULL)
+        return SWTIMER_NONE;
+
+    swt_free = swt_pool[i].next;
+
+    swt_pool[i].cb = cb;
+    swt_pool[i].period = 0;
+    swt_pool[i].slot = SWT_SLOT_NONE;
+
+    /* A stale queue entry of the previous owner stays accounted for */
+    swt_lock();
+    swt_pool[i].flags = (swt_pool[i].flags & SWT_QUEUED) |
+                        SWT_USED | (flags & SWTIMER_ISR);
+    swt_unlock();
+
+    return i;
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Delete
+ *
+ * @brief   Stops a timer and returns it to the pool.
+ *
+ * @param   t - Timer handle
+ *
+ * @return  none
+ */
+void SWTIMER_Delete(SWTimer_t t)
+{
+    if (t >= SWTIMER_MAX || !(swt_pool[t].flags & SWT_USED))
+        return;
+
+    SWTIMER_Stop(t);
+
+    swt_lock();
+    swt_pool[t].flags &= SWT_QUEUED;
+    swt_unlock();
+    swt_pool[t].next = swt_free;
+    swt_free = t;
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Start
+ *
+ * @brief   Arms (or re-arms) a timer.
+ *
+ * @param   t         - Timer handle
+ * @param   delay_ms  - Time to the first expiry (0 = next tick)
+ * @param   period_ms - Time between later expiries, 0 = one-shot
+ *
+ * @return  none
+ *
+ * @note    - O(1): one list insert.
+ *          - Periodic timers do not drift; each expiry is scheduled
+ *            from the previous one, not from the callback.
+ *          - A deferred callback still waiting in the queue is kept.
+ */
+void SWTIMER_Start(SWTimer_t t, uint32_t delay_ms, uint32_t period_ms)
+{
+    if (t >= SWTIMER_MAX || !(swt_pool[t].flags & SWT_USED))
+        return;
+
+    if (delay_ms == 0)
+        delay_ms = 1;
+
+    swt_lock();
+    swt_unlink(t);
+    swt_pool[t].expires = swt_now + delay_ms;
+    swt_pool[t].period = period_ms;
+    swt_link(t);
+    swt_unlock();
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Stop
+ *
+ * @brief   Disarms a timer.
+ *
+ * @param   t - Timer handle
+ *
+ * @return  none
+ *
+ * @note    Also drops a deferred callback that has not run yet; its
+ *          queue entry is skipped by SWTIMER_Poll() and reused if the
+ *          timer expires again first.
+ */
+void SWTIMER_Stop(SWTimer_t t)
+{
+    if (t >= SWTIMER_MAX)
+        return;
+
+    swt_lock();
+    swt_unlink(t);
+    swt_pool[t].flags &= ~SWT_PENDING;
+    swt_unlock();
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Active
+ *
+ * @brief   Checks whether a timer is armed.
+ *
+ * @param   t - Timer handle
+ *
+ * @return  uint8_t - 1 if the timer will expire again
+ */
+uint8_t SWTIMER_Active(SWTimer_t t)
+{
+    return (t < SWTIMER_MAX) && swt_pool[t].slot != SWT_SLOT_NONE;
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_Poll
+ *
+ * @brief   Runs the callbacks of expired deferred timers.
+ *
+ * @return  none
+ *
+ * @note    - Call from the super-loop.
+ *          - A timer that expires again before its callback has run
+ *            is reported once.
+ */
+void SWTIMER_Poll(void)
+{
+    while (swt_qhead != swt_qtail)
+    {
+        uint8_t head = swt_qhead;
+        uint8_t i = swt_queue[head];
+
+        swt_qhead = (head + 1 == SWT_QLEN) ? 0 : head + 1;
+
+        swt_lock();
+        uint8_t pending = swt_pool[i].flags & SWT_PENDING;
+        swt_pool[i].flags &= ~(SWT_PENDING | SWT_QUEUED);
+        swt_unlock();
+
+        if (pending)
+            swt_pool[i].cb(i);
+    }
+}
+
+/*********************************************************************
+ * @fn      SWTIMER_SetNotify
+ *
+ * @brief   Registers a function called when a deferred callback is
+ *          queued.
+ *
+ * @param   fn - Notify function (SysTick interrupt context) or NULL
+ *
+ * @return  none
+ *
+ * @note    Lets an event loop sleep until SWTIMER_Poll() has work.
+ */
+void SWTIMER_SetNotify(void (*fn)(void))
+{
+    swt_notify = fn;
+}
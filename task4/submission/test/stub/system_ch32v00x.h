@@ -0,0 +1,10 @@
+#ifndef __SYSTEM_CH32V00x_H
+#define __SYSTEM_CH32V00x_H
+
+/* Host-build stand-in for the WCH SDK header */
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+void SystemInit(void);
+
+#endif
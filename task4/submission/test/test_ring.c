@@ -0,0 +1,181 @@
+/*
+ * Host test: ring.h under two real threads (producer and consumer).
+ *
+ * Build and run (from task4/submission):
+ *   gcc -std=gnu11 -O2 -Wall -pthread -iquote include test/test_ring.c -o /tmp/test_ring && /tmp/test_ring
+ *
+ * On the host __riscv is not defined, so RING_ACQUIRE/RING_RELEASE are
+ * the __atomic_thread_fence() branch. Each pass streams TEST_BYTES
+ * through a small ring and the consumer checks every byte against the
+ * sequence the producer wrote, so a byte read before it was published,
+ * or a slot overwritten before it was consumed, shows up as a mismatch.
+ * Odd chunk sizes make the bulk and zero-copy paths cross the wrap.
+ */
+#include <pthread.h>
+#include <sched.h>          /* system one: -iquote keeps include/sched.h out */
+#include <stdio.h>
+#include "ring.h"
+
+#define TEST_BYTES  2000000UL
+#define TEST_RING   64
+
+RING_STATIC(ring, TEST_RING);
+
+typedef enum { PATH_SINGLE, PATH_BULK, PATH_ZEROCOPY } Path_t;
+
+static Path_t   path;
+static unsigned long errors;
+static unsigned long first_bad = ~0UL;
+
+// Byte i of the stream; not a multiple of the ring size so laps differ
+static uint8_t seq(unsigned long i)
+{
+    return (uint8_t)(i * 131U + (i >> 8));
+}
+
+// Chunk length 1..13 for step k
+static uint16_t chunk(unsigned long k)
+{
+    return (uint16_t)(1 + (k * 7U) % 13U);
+}
+
+static void check(unsigned long i, uint8_t b)
+{
+    if (b != seq(i))
+    {
+        if (errors == 0)
+            first_bad = i;
+        errors++;
+    }
+}
+
+static void *producer(void *arg)
+{
+    unsigned long i = 0, k = 0;
+    uint8_t tmp[16];
+    (void)arg;
+
+    while (i < TEST_BYTES)
+    {
+        uint16_t n = chunk(k++), done = 0;
+
+        if (n > TEST_BYTES - i)
+            n = (uint16_t)(TEST_BYTES - i);
+
+        switch (path)
+        {
+        case PATH_SINGLE:
+            done = ring_push(&ring, seq(i));
+            break;
+
+        case PATH_BULK:
+            for (uint16_t j = 0; j < n; j++)
+                tmp[j] = seq(i + j);
+            done = ring_push_bulk(&ring, tmp, n);
+            break;
+
+        case PATH_ZEROCOPY:
+        {
+            uint8_t *p;
+            uint16_t m = ring_reserve(&ring, &p);
+
+            if (m > n)
+                m = n;
+            for (uint16_t j = 0; j < m; j++)
+                p[j] = seq(i + j);
+            ring_publish(&ring, m);
+            done = m;
+            break;
+        }
+        }
+
+        i += done;
+        if (done == 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    unsigned long i = 0, k = 0;
+    uint8_t tmp[16];
+    (void)arg;
+
+    while (i < TEST_BYTES)
+    {
+        uint16_t n = chunk(k++), done = 0;
+
+        switch (path)
+        {
+        case PATH_SINGLE:
+            done = ring_pop(&ring, &tmp[0]);
+            if (done)
+                check(i, tmp[0]);
+            break;
+
+        case PATH_BULK:
+            done = ring_pop_bulk(&ring, tmp, n);
+            for (uint16_t j = 0; j < done; j++)
+                check(i + j, tmp[j]);
+            break;
+
+        case PATH_ZEROCOPY:
+        {
+            uint8_t *p;
+            uint16_t m = ring_peek(&ring, &p);
+
+            if (m > n)
+                m = n;
+            for (uint16_t j = 0; j < m; j++)
+                check(i + j, p[j]);
+            ring_commit(&ring, m);
+            done = m;
+            break;
+        }
+        }
+
+        i += done;
+        if (done == 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static unsigned run(Path_t p, const char *name)
+{
+    pthread_t prod, cons;
+
+    path = p;
+    errors = 0;
+    first_bad = ~0UL;
+
+    pthread_create(&cons, NULL, consumer, NULL);
+    pthread_create(&prod, NULL, producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+
+    if (errors != 0 || ring_count(&ring) != 0)
+    {
+        printf("FAIL %-9s %lu bad bytes (first at %lu), %u left\n",
+               name, errors, first_bad, ring_count(&ring));
+        return 1;
+    }
+
+    printf("ok   %-9s %lu bytes\n", name, TEST_BYTES);
+    return 0;
+}
+
+int main(void)
+{
+    unsigned failures = 0;
+
+    failures += run(PATH_SINGLE, "single");
+    failures += run(PATH_BULK, "bulk");
+    failures += run(PATH_ZEROCOPY, "zerocopy");
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures != 0;
+}
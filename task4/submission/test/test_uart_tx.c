@@ -0,0 +1,207 @@
+/*
+ * Host test: USART1 TX ring buffer against a simulated register block.
+ *
+ * Build and run (from task4/submission):
+ *   gcc -std=gnu11 -Wall -DUART_HOST_SIM -Iinclude -Itest/stub test/test_uart_tx.c src/driver_uart_debug.c -o /tmp/test_uart_tx && /tmp/test_uart_tx
+ *
+ * A SIGALRM timer plays the USART: every tick it calls
+ * USART1_IRQHandler() while TXEIE is set and logs what the handler
+ * wrote to DATAR. Like a real interrupt, the signal preempts the test
+ * at any point and runs to completion.
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include "driver_usart_debug.h"
+#include "driver_gpio_pin.h"
+
+USART_RegDef_t USART1_Sim;
+
+#define DATAR_EMPTY 0xFFFF
+
+static volatile char     sent[4096];
+static volatile uint16_t sent_len;
+static unsigned          failures;
+
+/* Link stubs: HAL_UART_Init() is not used on the host */
+void HAL_GPIO_InitTable(const GPIO_PinConfig_t *table, uint8_t count) { (void)table; (void)count; }
+void HAL_PFIC_EnableIRQ(IRQn_t irq) { (void)irq; }
+
+#define CHECK(cond, ...)                                        \
+    do {                                                        \
+        if (!(cond)) {                                          \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);         \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+            failures++;                                         \
+        }                                                       \
+    } while (0)
+
+/* One character time of the simulated transmitter */
+static void usart_tick(int sig)
+{
+    (void)sig;
+
+    if (!(USART1_Sim.CTLR1 & USART_TXEIE))
+    {
+        USART1_Sim.STATR = USART_TXE | USART_TC;
+        return;
+    }
+
+    USART1_Sim.STATR = USART_TXE;
+    USART1_Sim.DATAR = DATAR_EMPTY;
+    USART1_IRQHandler();
+
+    if (USART1_Sim.DATAR != DATAR_EMPTY)
+    {
+        if (sent_len < sizeof(sent))
+            sent[sent_len++] = (char)USART1_Sim.DATAR;
+    }
+    else
+        USART1_Sim.STATR = USART_TXE | USART_TC;
+}
+
+static void usart_run(int on)
+{
+    struct itimerval it = { { 0, 20 }, { 0, 20 } };
+
+    if (!on)
+        memset(&it, 0, sizeof(it));
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+static void sent_reset(void)
+{
+    sent_len = 0;
+}
+
+static int sent_is(const char *s)
+{
+    return sent_len == strlen(s) && memcmp((const char *)sent, s, sent_len) == 0;
+}
+
+/* Fill the buffer with n 'x' bytes while the transmitter is stopped */
+static void fill(uint16_t n)
+{
+    HAL_UART_SetTxPolicy(UART_TX_DROP);
+    while (n--)
+        HAL_UART_SendChar('x');
+}
+
+static void test_fifo_order(void)
+{
+    char expect[64];
+    int n = 0;
+
+    sent_reset();
+    usart_run(1);
+    HAL_UART_SetTxPolicy(UART_TX_BLOCK);
+
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        HAL_UART_SendChar(c);
+        expect[n++] = c;
+    }
+    HAL_UART_SendString("0123456789");
+    memcpy(&expect[n], "0123456789", 11);
+
+    HAL_UART_Flush();
+    usart_run(0);
+
+    CHECK(sent_is(expect), "bytes out of order (%u sent)", sent_len);
+}
+
+static void test_block(void)
+{
+    static char big[3 * UART_TX_BUF_SIZE + 1];
+    uint32_t dropped = HAL_UART_GetDropped();
+
+    for (unsigned i = 0; i < sizeof(big) - 1; i++)
+        big[i] = 'A' + (i % 26);
+
+    sent_reset();
+    usart_run(1);
+    HAL_UART_SetTxPolicy(UART_TX_BLOCK);
+    HAL_UART_SendString(big);            // 3x the buffer: must wait
+    HAL_UART_Flush();
+    usart_run(0);
+
+    CHECK(sent_is(big), "BLOCK lost data (%u of %u sent)",
+          sent_len, (unsigned)sizeof(big) - 1);
+    CHECK(HAL_UART_GetDropped() == dropped, "BLOCK counted drops");
+}
+
+static void test_drop(void)
+{
+    uint32_t dropped = HAL_UART_GetDropped();
+
+    sent_reset();
+    fill(UART_TX_BUF_SIZE - 4);
+
+    HAL_UART_SetTxPolicy(UART_TX_DROP);
+    HAL_UART_SendString("12345");        // does not fit: dropped whole
+    CHECK(HAL_UART_GetDropped() == dropped + 5, "DROP count %lu",
+          (unsigned long)(HAL_UART_GetDropped() - dropped));
+
+    HAL_UART_SendString("abcd");         // fits exactly
+    HAL_UART_SendChar('!');              // full: single byte dropped
+    CHECK(HAL_UART_GetDropped() == dropped + 6, "DROP char count");
+
+    usart_run(1);
+    HAL_UART_Flush();
+    usart_run(0);
+
+    CHECK(sent_len == UART_TX_BUF_SIZE, "DROP sent %u", sent_len);
+    CHECK(memcmp((const char *)&sent[UART_TX_BUF_SIZE - 4], "abcd", 4) == 0,
+          "DROP tail wrong");
+}
+
+static void test_truncate(void)
+{
+    uint32_t dropped = HAL_UART_GetDropped();
+
+    sent_reset();
+    fill(UART_TX_BUF_SIZE - 3);
+
+    HAL_UART_SetTxPolicy(UART_TX_TRUNCATE);
+    HAL_UART_SendString("ABCDEFG");      // 3 fit, 4 dropped
+    CHECK(HAL_UART_GetDropped() == dropped + 4, "TRUNCATE count %lu",
+          (unsigned long)(HAL_UART_GetDropped() - dropped));
+
+    usart_run(1);
+    HAL_UART_Flush();
+    usart_run(0);
+
+    CHECK(sent_len == UART_TX_BUF_SIZE, "TRUNCATE sent %u", sent_len);
+    CHECK(memcmp((const char *)&sent[UART_TX_BUF_SIZE - 3], "ABC", 3) == 0,
+          "TRUNCATE kept the wrong bytes");
+}
+
+static void test_flush(void)
+{
+    sent_reset();
+    fill(UART_TX_BUF_SIZE);
+
+    usart_run(1);
+    HAL_UART_Flush();
+    CHECK(sent_len == UART_TX_BUF_SIZE, "Flush returned early (%u sent)", sent_len);
+    CHECK(!(USART1_Sim.CTLR1 & USART_TXEIE), "TXEIE still armed");
+    CHECK(USART1_Sim.STATR & USART_TC, "Flush returned before TC");
+    usart_run(0);
+}
+
+int main(void)
+{
+    signal(SIGALRM, usart_tick);
+    USART1_Sim.STATR = USART_TXE | USART_TC;
+
+    test_fifo_order();
+    test_block();
+    test_drop();
+    test_truncate();
+    test_flush();
+
+    printf("%s (%u failures)\n", failures ? "FAILED" : "OK", failures);
+    return failures != 0;
+}